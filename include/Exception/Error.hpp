@@ -12,6 +12,11 @@ namespace Framework {
 			InvalidArgument,
 			TypeMismatch,
 			InvalidOperation,
+			Timeout,
+			Rejected,
+			NoResult,
+			Overflow,
+			SystemError,
 		};
 	};
 } // namespace Framework
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <functional>
+#include <condition_variable>
+#include "IMessageQueue.hpp"
+#include "Exception/Exception.hpp"
+
+namespace Framework::Message {
+	enum class OverflowPolicy : uint8_t {
+		// Send waits until the consumer makes room.
+		BLOCK = 0,
+		// Send throws Overflow and TrySend returns false.
+		FAIL,
+		// The oldest queued message is discarded to make room.
+		DROP_OLDEST,
+		// The newest queued message that coalesces with the new one is replaced by it;
+		// without such a message Send waits as with BLOCK.
+		COALESCE,
+	};
+
+	// SynchronizedDeque holding at most capacity messages, with a policy for sends to a full queue.
+	template<typename T>
+	class BoundedDeque : public IMessageQueue<T> {
+	public:
+		struct Handlers {
+			// Messages it accepts bypass the capacity and are never discarded.
+			std::function<bool(const T &)> exempt{};
+			// Whether message may replace queued under COALESCE.
+			std::function<bool(const T &queued, const T &message)> coalesce{};
+			// Receives every message discarded by DROP_OLDEST or COALESCE, outside the queue lock.
+			std::function<void(T &&)> discard{};
+		};
+	private:
+		static constexpr auto WAIT_FOREVER = std::chrono::milliseconds::zero();
+		std::mutex _mutex;
+		std::condition_variable _condition;
+		std::condition_variable _spaceCondition;
+		std::deque<T> _queue{};
+		const std::size_t _capacity;
+		const OverflowPolicy _policy;
+		const Handlers _handlers;
+		// Queued messages that count against the capacity.
+		std::size_t _bounded{ 0 };
+		std::size_t _discarded{ 0 };
+
+		inline T _GetFront() {
+			T buffer = std::move(_queue.front());
+			_queue.pop_front();
+			if (!_IsExempt(buffer)) {
+				_bounded--;
+				_spaceCondition.notify_one();
+			}
+			return buffer;
+		}
+
+		inline bool IsNotEmpty() const {
+			return !_queue.empty();
+		}
+
+		bool _IsExempt(const T &message) const {
+			return _handlers.exempt && _handlers.exempt(message);
+		}
+
+		// Index of the message DROP_OLDEST or COALESCE would discard for message, if any.
+		std::optional<std::size_t> _FindVictim(const T &message) const {
+			if (_policy == OverflowPolicy::DROP_OLDEST) {
+				for (std::size_t i = 0; i < _queue.size(); i++) {
+					if (!_IsExempt(_queue[i])) {
+						return i;
+					}
+				}
+			} else if (_policy == OverflowPolicy::COALESCE && _handlers.coalesce) {
+				for (std::size_t i = _queue.size(); i-- > 0;) {
+					if (!_IsExempt(_queue[i]) && _handlers.coalesce(_queue[i], message)) {
+						return i;
+					}
+				}
+			}
+			return std::nullopt;
+		}
+
+		// Returns false when the message was refused under FAIL.
+		template<typename U>
+		bool _Push(U &&message) {
+			const bool exempt = _IsExempt(message);
+			std::optional<T> discarded;
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				if (!exempt) {
+					while (_bounded >= _capacity) {
+						if (_policy == OverflowPolicy::FAIL) {
+							return false;
+						}
+						if (auto victim = _FindVictim(message)) {
+							discarded.emplace(std::move(_queue[*victim]));
+							_discarded++;
+							if (_policy == OverflowPolicy::COALESCE) {
+								_queue[*victim] = std::forward<U>(message);
+							} else {
+								_queue.erase(_queue.begin() + static_cast<std::ptrdiff_t>(*victim));
+								_bounded--;
+							}
+							break;
+						}
+						_spaceCondition.wait(lock);
+					}
+				}
+				if (!discarded || _policy != OverflowPolicy::COALESCE) {
+					_queue.push_back(std::forward<U>(message));
+					_bounded += exempt ? 0 : 1;
+					_condition.notify_all();
+				}
+			}
+			if (discarded && _handlers.discard) {
+				_handlers.discard(std::move(*discarded));
+			}
+			return true;
+		}
+
+		[[noreturn]] static void _ThrowOverflow() {
+			throw Exception("Message queue is full", Error::Code::Overflow);
+		}
+
+	public:
+		explicit BoundedDeque(std::size_t capacity, OverflowPolicy policy = OverflowPolicy::BLOCK,
+			Handlers handlers = {}) :
+			_capacity(capacity == 0 ? 1 : capacity), _policy(policy), _handlers(std::move(handlers)) {}
+
+		using IMessageQueue<T>::Send;
+
+		void Send(T &&message) override {
+			if (!_Push(std::move(message))) {
+				_ThrowOverflow();
+			}
+		}
+
+		bool TrySend(T &&message) override {
+			return _Push(std::move(message));
+		}
+
+		T Receive() override {
+			std::unique_lock<std::mutex> lock(_mutex);
+			_condition.wait(lock, [this] { return IsNotEmpty(); });
+			return _GetFront();
+		}
+
+		std::pair<bool, T> TryReceive() override {
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (IsNotEmpty()) {
+				return { true, _GetFront() };
+			}
+			return { false, T{} };
+		}
+
+		std::pair<bool, T> TimedReceive(const std::chrono::milliseconds milliSeconds) override {
+			std::unique_lock<std::mutex> lock(_mutex);
+			if (_condition.wait_for(lock, milliSeconds, [this] { return IsNotEmpty(); })) {
+				return { true, _GetFront() };
+			}
+			return { false, T{} };
+		}
+
+		std::size_t ReceiveBatch(std::deque<T> &messages, std::size_t maxCount,
+			const std::chrono::milliseconds milliSeconds = WAIT_FOREVER) override {
+			std::unique_lock<std::mutex> lock(_mutex);
+			if (milliSeconds == WAIT_FOREVER) {
+				_condition.wait(lock, [this] { return IsNotEmpty(); });
+			} else if (!_condition.wait_for(lock, milliSeconds, [this] { return IsNotEmpty(); })) {
+				return 0;
+			}
+			std::size_t count = 0;
+			const std::size_t bounded = _bounded;
+			while (IsNotEmpty() && count < maxCount) {
+				messages.push_back(std::move(_queue.front()));
+				_queue.pop_front();
+				_bounded -= _IsExempt(messages.back()) ? 0 : 1;
+				count++;
+			}
+			if (_bounded != bounded) {
+				_spaceCondition.notify_all();
+			}
+			return count;
+		}
+
+		void Clear() override {
+			std::lock_guard<std::mutex> lock(_mutex);
+			_queue.clear();
+			_bounded = 0;
+			_spaceCondition.notify_all();
+		}
+
+		bool IsEmpty() override {
+			std::lock_guard<std::mutex> lock(_mutex);
+			return _queue.empty();
+		}
+
+		std::size_t NumMessages() override {
+			std::lock_guard<std::mutex> lock(_mutex);
+			return _queue.size();
+		}
+
+		std::size_t Capacity() const {
+			return _capacity;
+		}
+
+		// Messages discarded so far by DROP_OLDEST or COALESCE.
+		std::size_t CountDiscarded() {
+			std::lock_guard<std::mutex> lock(_mutex);
+			return _discarded;
+		}
+	};
+} // namespace Framework::Message
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <string>
+#include <type_traits>
+#include "IMessageQueue.hpp"
+
+namespace Framework::Message {
+	// IMessageQueue over a cross-process channel carrying fixed-size T_SIZE byte messages. The channel
+	// reserves HEADER_SIZE bytes in front of each message for its own use. Messages are copied
+	// bytewise, so T must be trivially copyable and must not point into its sender's memory.
+	template<class Channel, class T, std::size_t T_SIZE = sizeof(T)>
+	class ChannelQueue final : public IMessageQueue<T, T_SIZE> {
+		static_assert(std::is_trivially_copyable_v<T>, "cross-process messages must be trivially copyable");
+		static_assert(T_SIZE >= sizeof(T), "T_SIZE must hold the whole message");
+
+		static constexpr auto WAIT_FOREVER = std::chrono::milliseconds::zero();
+
+		struct _Buffer {
+			alignas(std::max_align_t) std::array<std::byte, Channel::HEADER_SIZE + T_SIZE> bytes{};
+
+			void *Data() { return bytes.data(); }
+			std::byte *Message() { return bytes.data() + Channel::HEADER_SIZE; }
+		};
+
+		Channel _channel;
+
+		static _Buffer _Encode(const T &message) {
+			_Buffer buffer;
+			std::memcpy(buffer.Message(), &message, sizeof(T));
+			return buffer;
+		}
+
+		static T _Decode(_Buffer &buffer) {
+			alignas(T) std::byte storage[sizeof(T)];
+			std::memcpy(storage, buffer.Message(), sizeof(T));
+			return *std::launder(reinterpret_cast<T *>(storage));
+		}
+	public:
+		static constexpr std::size_t DEFAULT_CAPACITY = 10;
+
+		// Opens the channel called name, creating it with room for capacity messages if it does not exist.
+		explicit ChannelQueue(const std::string &name, std::size_t capacity = DEFAULT_CAPACITY) :
+			_channel(name, capacity, T_SIZE) {}
+
+		using IMessageQueue<T, T_SIZE>::Send;
+
+		void Send(T &&message) override {
+			_Buffer buffer = _Encode(message);
+			_channel.Send(buffer.Data());
+		}
+
+		// False when the channel is full.
+		bool TrySend(T &&message) override {
+			_Buffer buffer = _Encode(message);
+			return _channel.TrySend(buffer.Data());
+		}
+
+		T Receive() override {
+			_Buffer buffer;
+			_channel.Receive(buffer.Data());
+			return _Decode(buffer);
+		}
+
+		std::pair<bool, T> TryReceive() override {
+			_Buffer buffer;
+			if (!_channel.TryReceive(buffer.Data())) {
+				return { false, T{} };
+			}
+			return { true, _Decode(buffer) };
+		}
+
+		std::pair<bool, T> TimedReceive(const std::chrono::milliseconds milliSec) override {
+			_Buffer buffer;
+			if (!_channel.TimedReceive(buffer.Data(), milliSec)) {
+				return { false, T{} };
+			}
+			return { true, _Decode(buffer) };
+		}
+
+		std::size_t ReceiveBatch(std::deque<T> &messages, std::size_t maxCount,
+			const std::chrono::milliseconds milliSec = WAIT_FOREVER) override {
+			if (maxCount == 0) {
+				return 0;
+			}
+			if (milliSec == WAIT_FOREVER) {
+				messages.push_back(Receive());
+			} else {
+				auto [received, message] = TimedReceive(milliSec);
+				if (!received) {
+					return 0;
+				}
+				messages.push_back(message);
+			}
+			std::size_t count = 1;
+			for (; count < maxCount; count++) {
+				auto [received, message] = TryReceive();
+				if (!received) {
+					break;
+				}
+				messages.push_back(message);
+			}
+			return count;
+		}
+
+		bool IsEmpty() override {
+			return _channel.Count() == 0;
+		}
+
+		void Clear() override {
+			_Buffer buffer;
+			while (_channel.TryReceive(buffer.Data())) {}
+		}
+
+		std::size_t NumMessages() override {
+			return _channel.Count();
+		}
+
+		// Removes the channel from the system; processes that still have it open keep using it.
+		void Unlink() {
+			_channel.Unlink();
+		}
+	};
+} // namespace Framework::Message
@@ -1,17 +1,35 @@
 #pragma once
 
 #include <map>
+#include <deque>
 #include <chrono>
 #include <cstddef>
+#include <type_traits>
+#include <utility>
 
 namespace Framework::Message {
 	template<class T, std::size_t T_SIZE = sizeof(T)>
 	class IMessageQueue {
 	public:
-		virtual void Send(const T &message) = 0;
+		virtual ~IMessageQueue() = default;
+
+		// Sends a copy; move-only messages must be sent as rvalues.
+		void Send(const T &message) requires std::is_copy_constructible_v<T> {
+			Send(T(message));
+		}
 		virtual void Send(T &&message) = 0;
+		// False when a bounded queue refuses the message instead of accepting it.
+		virtual bool TrySend(T &&message) {
+			Send(std::move(message));
+			return true;
+		}
 		virtual T Receive() = 0;
+		// Returns at once; false when no message is queued.
+		virtual std::pair<bool, T> TryReceive() = 0;
 		virtual std::pair<bool, T> TimedReceive(const std::chrono::milliseconds milliSec) = 0;
+		// Appends up to maxCount messages once at least one is available; zero waits forever.
+		virtual std::size_t ReceiveBatch(std::deque<T> &messages, std::size_t maxCount,
+			const std::chrono::milliseconds milliSec = std::chrono::milliseconds::zero()) = 0;
 		virtual bool IsEmpty() = 0;
 		virtual void Clear() = 0;
 		virtual std::size_t NumMessages() = 0;
@@ -1,15 +1,63 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <type_traits>
 #include "IMessageQueue.hpp"
 #include "SynchronizedDeque.hpp"
+#include "RingBuffer.hpp"
+#include "BoundedDeque.hpp"
+#include "Posix.hpp"
+#include "SystemV.hpp"
+#include "SharedRingBuffer.hpp"
+#include "Exception/Exception.hpp"
 
 namespace Framework::Message {
 	class MessageQueueFactory final {
 	public:
+		enum class Type : uint8_t {
+			SYNCHRONIZED_DEQUE = 0,
+			RING_BUFFER,
+			BOUNDED_DEQUE,
+			POSIX_MQUEUE,
+			SYSTEM_V,
+			SHARED_RING_BUFFER,
+		};
+
+		template<typename T>
+		static IMessageQueue<T> *Create(Type type = Type::SYNCHRONIZED_DEQUE,
+			std::size_t capacity = RingBuffer<T>::DEFAULT_CAPACITY, OverflowPolicy overflow = OverflowPolicy::BLOCK) {
+			switch (type) {
+			case Type::RING_BUFFER:
+				return new RingBuffer<T>(capacity);
+			case Type::BOUNDED_DEQUE:
+				return new BoundedDeque<T>(capacity, overflow);
+			case Type::POSIX_MQUEUE:
+			case Type::SYSTEM_V:
+			case Type::SHARED_RING_BUFFER:
+				throw Exception("Cross-process message queues need a name", Error::Code::InvalidArgument);
+			case Type::SYNCHRONIZED_DEQUE:
+			default:
+				return new SynchronizedDeque<T>();
+			}
+		}
+
+		// Cross-process queues are opened by name, so another process creating the same type and name
+		// shares the queue. In-process types ignore the name.
 		template<typename T>
-		static IMessageQueue<T> *Create() {
-			return new SynchronizedDeque<T>();
+		static IMessageQueue<T> *Create(Type type, const std::string &name,
+			std::size_t capacity = ChannelQueue<Posix::Channel, T>::DEFAULT_CAPACITY) {
+			static_assert(std::is_trivially_copyable_v<T>, "cross-process messages must be trivially copyable");
+			switch (type) {
+			case Type::POSIX_MQUEUE:
+				return new PosixQueue<T>(name, capacity);
+			case Type::SYSTEM_V:
+				return new SystemVQueue<T>(name, capacity);
+			case Type::SHARED_RING_BUFFER:
+				return new SharedRingBuffer<T>(name, capacity);
+			default:
+				return Create<T>(type, capacity);
+			}
 		}
 	};
 } // namespace Framework::Message
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include "ChannelQueue.hpp"
+
+namespace Framework::Message {
+	namespace Posix {
+		// POSIX message queue (mq_*) carrying messages of exactly messageSize bytes.
+		class Channel final {
+			int _descriptor{ -1 };
+			std::string _path;
+			std::size_t _messageSize;
+		public:
+			static constexpr std::size_t HEADER_SIZE = 0;
+
+			// The queue is named /framework.<name>, so name must not contain '/'.
+			static std::string Path(const std::string &name);
+
+			Channel(const std::string &name, std::size_t capacity, std::size_t messageSize);
+			~Channel();
+			Channel(const Channel &) = delete;
+			Channel &operator=(const Channel &) = delete;
+
+			void Send(const void *message);
+			bool TrySend(const void *message);
+			void Receive(void *message);
+			bool TryReceive(void *message);
+			bool TimedReceive(void *message, std::chrono::milliseconds timeout);
+			std::size_t Count();
+			void Unlink();
+		};
+	} // namespace Posix
+
+	template<class T, std::size_t T_SIZE = sizeof(T)>
+	using PosixQueue = ChannelQueue<Posix::Channel, T, T_SIZE>;
+} // namespace Framework::Message
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include "IMessageQueue.hpp"
+#include "Sync/Futex.hpp"
+
+namespace Framework::Message {
+	// Bounded multi-producer / single-consumer queue.
+	// Receive, TryReceive, TimedReceive, ReceiveBatch and Clear must only be called from the consumer thread.
+	template<typename T>
+	class RingBuffer : public IMessageQueue<T> {
+	public:
+		static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+	private:
+		static constexpr auto WAIT_FOREVER = std::chrono::milliseconds::zero();
+		static constexpr std::size_t CACHE_LINE_SIZE = 64;
+		static constexpr int SPIN_COUNT = 64;
+
+		struct Slot {
+			std::atomic<std::size_t> sequence{ 0 };
+			T value{};
+		};
+
+		alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> _tail{ 0 };
+		alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> _head{ 0 };
+		alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> _consumerSleeping{ 0 };
+		alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> _spaceSignal{ 0 };
+		std::atomic<uint32_t> _waitingProducers{ 0 };
+		alignas(CACHE_LINE_SIZE) const std::size_t _mask;
+		std::unique_ptr<Slot[]> _slots;
+
+		template<typename U>
+		void _Push(U &&message) {
+			std::size_t position = _tail.load(std::memory_order_relaxed);
+			Slot *slot;
+			while (true) {
+				slot = &_slots[position & _mask];
+				std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+				auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+				if (difference == 0) {
+					if (_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+						break;
+					}
+				} else if (difference < 0) {
+					_WaitForSpace(*slot, sequence);
+					position = _tail.load(std::memory_order_relaxed);
+				} else {
+					position = _tail.load(std::memory_order_relaxed);
+				}
+			}
+			slot->value = std::forward<U>(message);
+			slot->sequence.store(position + 1, std::memory_order_release);
+			_WakeConsumer();
+		}
+
+		bool _TryPop(T &message) {
+			std::size_t position = _head.load(std::memory_order_relaxed);
+			Slot &slot = _slots[position & _mask];
+			if (slot.sequence.load(std::memory_order_acquire) != position + 1) {
+				return false;
+			}
+			message = std::move(slot.value);
+			slot.sequence.store(position + _mask + 1, std::memory_order_release);
+			_head.store(position + 1, std::memory_order_release);
+			_WakeProducers();
+			return true;
+		}
+
+		bool _IsReadable() const {
+			std::size_t position = _head.load(std::memory_order_relaxed);
+			return _slots[position & _mask].sequence.load(std::memory_order_acquire) == position + 1;
+		}
+
+		void _WakeConsumer() {
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (_consumerSleeping.load(std::memory_order_relaxed) &&
+				_consumerSleeping.exchange(0, std::memory_order_acq_rel)) {
+				Sync::Futex::Wake(_consumerSleeping);
+			}
+		}
+
+		void _WakeProducers() {
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (_waitingProducers.load(std::memory_order_relaxed)) {
+				_spaceSignal.fetch_add(1, std::memory_order_release);
+				Sync::Futex::WakeAll(_spaceSignal);
+			}
+		}
+
+		void _WaitForSpace(const Slot &slot, std::size_t fullSequence) {
+			_waitingProducers.fetch_add(1, std::memory_order_seq_cst);
+			uint32_t signal = _spaceSignal.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (slot.sequence.load(std::memory_order_acquire) == fullSequence) {
+				Sync::Futex::Wait(_spaceSignal, signal);
+			}
+			_waitingProducers.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		// Returns false when the deadline passed without a message becoming readable.
+		bool _WaitForMessage(std::chrono::steady_clock::time_point deadline, bool timed) {
+			for (int i = 0; i < SPIN_COUNT; i++) {
+				if (_IsReadable()) {
+					return true;
+				}
+			}
+			while (true) {
+				std::chrono::milliseconds remaining = WAIT_FOREVER;
+				if (timed) {
+					remaining = std::chrono::ceil<std::chrono::milliseconds>(
+						deadline - std::chrono::steady_clock::now());
+					if (remaining <= std::chrono::milliseconds::zero()) {
+						return _IsReadable();
+					}
+				}
+				_consumerSleeping.store(1, std::memory_order_relaxed);
+				// Pairs with the fence in _WakeConsumer: either the producer sees the flag or the consumer sees its message.
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if (_IsReadable()) {
+					_consumerSleeping.store(0, std::memory_order_relaxed);
+					return true;
+				}
+				Sync::Futex::Wait(_consumerSleeping, 1, remaining);
+				_consumerSleeping.store(0, std::memory_order_relaxed);
+				if (_IsReadable()) {
+					return true;
+				}
+			}
+		}
+
+	public:
+		explicit RingBuffer(std::size_t capacity = DEFAULT_CAPACITY) :
+			_mask(std::bit_ceil(capacity < 2 ? std::size_t{ 2 } : capacity) - 1),
+			_slots(std::make_unique<Slot[]>(_mask + 1)) {
+			for (std::size_t i = 0; i <= _mask; i++) {
+				_slots[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		using IMessageQueue<T>::Send;
+
+		void Send(T &&message) override {
+			_Push(std::move(message));
+		}
+
+		T Receive() override {
+			T message{};
+			while (!_TryPop(message)) {
+				_WaitForMessage({}, false);
+			}
+			return message;
+		}
+
+		std::pair<bool, T> TryReceive() override {
+			T message{};
+			if (_TryPop(message)) {
+				return { true, std::move(message) };
+			}
+			return { false, T{} };
+		}
+
+		std::pair<bool, T> TimedReceive(const std::chrono::milliseconds milliSeconds) override {
+			T message{};
+			auto deadline = std::chrono::steady_clock::now() + milliSeconds;
+			if (_TryPop(message) || (_WaitForMessage(deadline, true) && _TryPop(message))) {
+				return { true, std::move(message) };
+			}
+			return { false, T{} };
+		}
+
+		std::size_t ReceiveBatch(std::deque<T> &messages, std::size_t maxCount,
+			const std::chrono::milliseconds milliSeconds = WAIT_FOREVER) override {
+			auto deadline = std::chrono::steady_clock::now() + milliSeconds;
+			if (!_IsReadable() && !_WaitForMessage(deadline, milliSeconds != WAIT_FOREVER)) {
+				return 0;
+			}
+			std::size_t count = 0;
+			T message{};
+			while (count < maxCount && _TryPop(message)) {
+				messages.push_back(std::move(message));
+				count++;
+			}
+			return count;
+		}
+
+		void Clear() override {
+			T message{};
+			while (_TryPop(message)) {}
+		}
+
+		bool IsEmpty() override {
+			return NumMessages() == 0;
+		}
+
+		std::size_t NumMessages() override {
+			std::size_t head = _head.load(std::memory_order_acquire);
+			std::size_t tail = _tail.load(std::memory_order_acquire);
+			return tail > head ? tail - head : 0;
+		}
+
+		std::size_t Capacity() const {
+			return _mask + 1;
+		}
+	};
+} // namespace Framework::Message
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace Framework::Message {
+	// A named POSIX shared memory region (shm_open + mmap) mapped read-write into this process.
+	class SharedMemory final {
+		std::string _path;
+		void *_address{ nullptr };
+		std::size_t _size;
+		bool _created{ false };
+	public:
+		// shm_open names are flat, so the path of name under Configuration::Address::Root() is used
+		// with its inner '/' replaced by '.', e.g. /tmp.framework.<name>.
+		static std::string Path(const std::string &name);
+
+		// Maps the region called name, creating it zero-filled with size bytes if it does not exist.
+		// An existing region must have exactly size bytes.
+		SharedMemory(const std::string &name, std::size_t size);
+		~SharedMemory();
+		SharedMemory(const SharedMemory &) = delete;
+		SharedMemory &operator=(const SharedMemory &) = delete;
+
+		void *Address() const { return _address; }
+		std::size_t Size() const { return _size; }
+		// True when this mapping created the region and so has to initialise it.
+		bool Created() const { return _created; }
+
+		// Removes the name; mappings that already exist stay valid.
+		void Unlink();
+	};
+} // namespace Framework::Message
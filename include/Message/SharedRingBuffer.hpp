@@ -0,0 +1,279 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include "IMessageQueue.hpp"
+#include "SharedMemory.hpp"
+#include "Sync/Futex.hpp"
+#include "Exception/Exception.hpp"
+
+namespace Framework::Message {
+	// Bounded multi-producer / single-consumer queue in named shared memory, so processes exchange
+	// messages without the kernel on the fast path. Same protocol as RingBuffer: a futex call is only
+	// made when the other side sleeps. Messages are copied bytewise into T_SIZE byte slots.
+	// Receive, TryReceive, TimedReceive, ReceiveBatch and Clear must only be called from one consumer
+	// thread across all processes.
+	template<class T, std::size_t T_SIZE = sizeof(T)>
+	class SharedRingBuffer final : public IMessageQueue<T, T_SIZE> {
+		static_assert(std::is_trivially_copyable_v<T>, "cross-process messages must be trivially copyable");
+		static_assert(T_SIZE >= sizeof(T), "T_SIZE must hold the whole message");
+		static_assert(std::atomic<std::size_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+			"shared memory needs address-free atomics");
+	public:
+		static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+	private:
+		static constexpr auto WAIT_FOREVER = std::chrono::milliseconds::zero();
+		static constexpr std::size_t CACHE_LINE_SIZE = 64;
+		static constexpr int SPIN_COUNT = 64;
+		static constexpr uint32_t READY = 0x474e4952;
+		// How long an opener waits for the creating process to initialise the queue.
+		static constexpr auto ATTACH_TIMEOUT = std::chrono::seconds(1);
+
+		struct Header {
+			std::atomic<uint32_t> ready{ 0 };
+			uint32_t messageSize{ 0 };
+			uint64_t capacity{ 0 };
+			alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> tail{ 0 };
+			alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> head{ 0 };
+			alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> consumerSleeping{ 0 };
+			alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> spaceSignal{ 0 };
+			std::atomic<uint32_t> waitingProducers{ 0 };
+		};
+
+		struct Slot {
+			std::atomic<std::size_t> sequence{ 0 };
+			std::byte value[T_SIZE];
+		};
+
+		const std::size_t _mask;
+		SharedMemory _memory;
+		Header *_header{ nullptr };
+		Slot *_slots{ nullptr };
+
+		static std::size_t _Capacity(std::size_t capacity) {
+			return std::bit_ceil(capacity < 2 ? std::size_t{ 2 } : capacity);
+		}
+
+		void _Initialize() {
+			auto *base = static_cast<std::byte *>(_memory.Address());
+			if (_memory.Created()) {
+				_header = ::new (base) Header{};
+				_header->messageSize = static_cast<uint32_t>(T_SIZE);
+				_header->capacity = _mask + 1;
+				_slots = reinterpret_cast<Slot *>(base + sizeof(Header));
+				for (std::size_t i = 0; i <= _mask; i++) {
+					::new (&_slots[i]) Slot{};
+					_slots[i].sequence.store(i, std::memory_order_relaxed);
+				}
+				_header->ready.store(READY, std::memory_order_release);
+				return;
+			}
+			_header = std::launder(reinterpret_cast<Header *>(base));
+			_slots = std::launder(reinterpret_cast<Slot *>(base + sizeof(Header)));
+			const auto deadline = std::chrono::steady_clock::now() + ATTACH_TIMEOUT;
+			while (_header->ready.load(std::memory_order_acquire) != READY) {
+				if (std::chrono::steady_clock::now() >= deadline) {
+					throw Exception("Shared ring buffer was never initialised", Error::Code::Timeout);
+				}
+				std::this_thread::yield();
+			}
+			if (_header->messageSize != T_SIZE || _header->capacity != _mask + 1) {
+				throw Exception("Shared ring buffer exists with another layout", Error::Code::InvalidArgument);
+			}
+		}
+
+		// Returns false instead of waiting when wait is false and the queue is full.
+		bool _Push(const T &message, bool wait) {
+			std::size_t position = _header->tail.load(std::memory_order_relaxed);
+			Slot *slot;
+			while (true) {
+				slot = &_slots[position & _mask];
+				std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+				auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+				if (difference == 0) {
+					if (_header->tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+						break;
+					}
+				} else if (difference < 0) {
+					if (!wait) {
+						return false;
+					}
+					_WaitForSpace(*slot, sequence);
+					position = _header->tail.load(std::memory_order_relaxed);
+				} else {
+					position = _header->tail.load(std::memory_order_relaxed);
+				}
+			}
+			std::memcpy(slot->value, &message, sizeof(T));
+			slot->sequence.store(position + 1, std::memory_order_release);
+			_WakeConsumer();
+			return true;
+		}
+
+		bool _TryPop(T &message) {
+			std::size_t position = _header->head.load(std::memory_order_relaxed);
+			Slot &slot = _slots[position & _mask];
+			if (slot.sequence.load(std::memory_order_acquire) != position + 1) {
+				return false;
+			}
+			std::memcpy(&message, slot.value, sizeof(T));
+			slot.sequence.store(position + _mask + 1, std::memory_order_release);
+			_header->head.store(position + 1, std::memory_order_release);
+			_WakeProducers();
+			return true;
+		}
+
+		bool _IsReadable() const {
+			std::size_t position = _header->head.load(std::memory_order_relaxed);
+			return _slots[position & _mask].sequence.load(std::memory_order_acquire) == position + 1;
+		}
+
+		void _WakeConsumer() {
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (_header->consumerSleeping.load(std::memory_order_relaxed) &&
+				_header->consumerSleeping.exchange(0, std::memory_order_acq_rel)) {
+				Sync::Futex::WakeShared(_header->consumerSleeping);
+			}
+		}
+
+		void _WakeProducers() {
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (_header->waitingProducers.load(std::memory_order_relaxed)) {
+				_header->spaceSignal.fetch_add(1, std::memory_order_release);
+				Sync::Futex::WakeAllShared(_header->spaceSignal);
+			}
+		}
+
+		void _WaitForSpace(const Slot &slot, std::size_t fullSequence) {
+			_header->waitingProducers.fetch_add(1, std::memory_order_seq_cst);
+			uint32_t signal = _header->spaceSignal.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (slot.sequence.load(std::memory_order_acquire) == fullSequence) {
+				Sync::Futex::WaitShared(_header->spaceSignal, signal);
+			}
+			_header->waitingProducers.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		// Returns false when the deadline passed without a message becoming readable.
+		bool _WaitForMessage(std::chrono::steady_clock::time_point deadline, bool timed) {
+			for (int i = 0; i < SPIN_COUNT; i++) {
+				if (_IsReadable()) {
+					return true;
+				}
+			}
+			while (true) {
+				std::chrono::milliseconds remaining = WAIT_FOREVER;
+				if (timed) {
+					remaining = std::chrono::ceil<std::chrono::milliseconds>(
+						deadline - std::chrono::steady_clock::now());
+					if (remaining <= std::chrono::milliseconds::zero()) {
+						return _IsReadable();
+					}
+				}
+				_header->consumerSleeping.store(1, std::memory_order_relaxed);
+				// Pairs with the fence in _WakeConsumer: either the producer sees the flag or the consumer sees its message.
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if (_IsReadable()) {
+					_header->consumerSleeping.store(0, std::memory_order_relaxed);
+					return true;
+				}
+				Sync::Futex::WaitShared(_header->consumerSleeping, 1, remaining);
+				_header->consumerSleeping.store(0, std::memory_order_relaxed);
+				if (_IsReadable()) {
+					return true;
+				}
+			}
+		}
+
+	public:
+		// Opens the queue called name, creating it with capacity rounded up to a power of two if it
+		// does not exist. Every process must open it with the same T_SIZE and capacity.
+		explicit SharedRingBuffer(const std::string &name, std::size_t capacity = DEFAULT_CAPACITY) :
+			_mask(_Capacity(capacity) - 1),
+			_memory(name, sizeof(Header) + _Capacity(capacity) * sizeof(Slot)) {
+			_Initialize();
+		}
+
+		using IMessageQueue<T, T_SIZE>::Send;
+
+		void Send(T &&message) override {
+			_Push(message, true);
+		}
+
+		// False when the queue is full.
+		bool TrySend(T &&message) override {
+			return _Push(message, false);
+		}
+
+		T Receive() override {
+			T message{};
+			while (!_TryPop(message)) {
+				_WaitForMessage({}, false);
+			}
+			return message;
+		}
+
+		std::pair<bool, T> TryReceive() override {
+			T message{};
+			if (_TryPop(message)) {
+				return { true, message };
+			}
+			return { false, T{} };
+		}
+
+		std::pair<bool, T> TimedReceive(const std::chrono::milliseconds milliSeconds) override {
+			T message{};
+			auto deadline = std::chrono::steady_clock::now() + milliSeconds;
+			if (_TryPop(message) || (_WaitForMessage(deadline, true) && _TryPop(message))) {
+				return { true, message };
+			}
+			return { false, T{} };
+		}
+
+		std::size_t ReceiveBatch(std::deque<T> &messages, std::size_t maxCount,
+			const std::chrono::milliseconds milliSeconds = WAIT_FOREVER) override {
+			auto deadline = std::chrono::steady_clock::now() + milliSeconds;
+			if (!_IsReadable() && !_WaitForMessage(deadline, milliSeconds != WAIT_FOREVER)) {
+				return 0;
+			}
+			std::size_t count = 0;
+			T message{};
+			while (count < maxCount && _TryPop(message)) {
+				messages.push_back(message);
+				count++;
+			}
+			return count;
+		}
+
+		void Clear() override {
+			T message{};
+			while (_TryPop(message)) {}
+		}
+
+		bool IsEmpty() override {
+			return NumMessages() == 0;
+		}
+
+		std::size_t NumMessages() override {
+			std::size_t head = _header->head.load(std::memory_order_acquire);
+			std::size_t tail = _header->tail.load(std::memory_order_acquire);
+			return tail > head ? tail - head : 0;
+		}
+
+		std::size_t Capacity() const {
+			return _mask + 1;
+		}
+
+		// Removes the name; processes that have the queue open keep using it.
+		void Unlink() {
+			_memory.Unlink();
+		}
+	};
+} // namespace Framework::Message
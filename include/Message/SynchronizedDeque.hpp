@@ -26,11 +26,7 @@ namespace Framework::Message {
 	public:
 		SynchronizedDeque() = default;
 
-		void Send(const T &message) override {
-			std::lock_guard<std::mutex> lock(_mutex);
-			_queue.push_back(message);
-			_condition.notify_all();
-		}
+		using IMessageQueue<T>::Send;
 
 		void Send(T &&message) override {
 			std::lock_guard<std::mutex> lock(_mutex);
@@ -44,6 +40,14 @@ namespace Framework::Message {
 			return _GetFront();
 		}
 
+		std::pair<bool, T> TryReceive() override {
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (IsNotEmpty()) {
+				return { true, _GetFront() };
+			}
+			return { false, T{} };
+		}
+
 		std::pair<bool, T> TimedReceive(const std::chrono::milliseconds milliSeconds) override {
 			std::unique_lock<std::mutex> lock(_mutex);
 			if (_condition.wait_for(lock, milliSeconds, [this] { return IsNotEmpty(); })) {
@@ -52,6 +56,26 @@ namespace Framework::Message {
 			return { false, T{} };
 		}
 
+		std::size_t ReceiveBatch(std::deque<T> &messages, std::size_t maxCount,
+			const std::chrono::milliseconds milliSeconds = WAIT_FOREVER) override {
+			std::unique_lock<std::mutex> lock(_mutex);
+			if (milliSeconds == WAIT_FOREVER) {
+				_condition.wait(lock, [this] { return IsNotEmpty(); });
+			} else if (!_condition.wait_for(lock, milliSeconds, [this] { return IsNotEmpty(); })) {
+				return 0;
+			}
+			if (messages.empty() && _queue.size() <= maxCount) {
+				_queue.swap(messages);
+				return messages.size();
+			}
+			std::size_t count = 0;
+			while (IsNotEmpty() && count < maxCount) {
+				messages.push_back(_GetFront());
+				count++;
+			}
+			return count;
+		}
+
 		void Clear() override {
 			std::lock_guard<std::mutex> lock(_mutex);
 			_queue.clear();
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include "ChannelQueue.hpp"
+
+namespace Framework::Message {
+	namespace SystemV {
+		// System V message queue (msgsnd/msgrcv) carrying messages of exactly messageSize bytes.
+		class Channel final {
+			int _id{ -1 };
+			std::string _path;
+			std::size_t _messageSize;
+
+			void _Resize(std::size_t capacity);
+		public:
+			// msgsnd/msgrcv buffers start with the message type.
+			static constexpr std::size_t HEADER_SIZE = sizeof(long);
+
+			// The queue key is derived from this file, created on demand under Configuration::Address::Root().
+			static std::string Path(const std::string &name);
+
+			// Only the process that creates the queue sizes it to capacity messages; later openers
+			// use the existing queue as it is. Without CAP_SYS_RESOURCE a queue cannot grow past the
+			// system default (MSGMNB) and holds fewer messages than asked for.
+			Channel(const std::string &name, std::size_t capacity, std::size_t messageSize);
+			Channel(const Channel &) = delete;
+			Channel &operator=(const Channel &) = delete;
+
+			void Send(void *message);
+			bool TrySend(void *message);
+			void Receive(void *message);
+			bool TryReceive(void *message);
+			// System V has no timed receive, so this polls until timeout.
+			bool TimedReceive(void *message, std::chrono::milliseconds timeout);
+			std::size_t Count();
+			// Removes the queue and its key file.
+			void Unlink();
+		};
+	} // namespace SystemV
+
+	template<class T, std::size_t T_SIZE = sizeof(T)>
+	using SystemVQueue = ChannelQueue<SystemV::Channel, T, T_SIZE>;
+} // namespace Framework::Message
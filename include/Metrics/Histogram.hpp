@@ -0,0 +1,135 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace Framework::Metrics {
+	// Point-in-time copy of a Histogram; cheap to merge and query.
+	class HistogramSnapshot {
+		std::vector<uint64_t> _counts{};
+		uint64_t _subBuckets{ 1 };
+		uint64_t _count{ 0 };
+		uint64_t _sum{ 0 };
+		uint64_t _min{ std::numeric_limits<uint64_t>::max() };
+		uint64_t _max{ 0 };
+
+		template <std::size_t SUB_BUCKET_BITS>
+		friend class Histogram;
+	public:
+		uint64_t Count() const { return _count; }
+		uint64_t Sum() const { return _sum; }
+		uint64_t Min() const { return _count == 0 ? 0 : _min; }
+		uint64_t Max() const { return _max; }
+		double Mean() const { return _count == 0 ? 0.0 : static_cast<double>(_sum) / static_cast<double>(_count); }
+
+		// Upper bound of the bucket holding the given percentile (0-100), clamped to Max().
+		uint64_t Percentile(double percentile) const;
+
+		// Both snapshots must come from histograms with the same bucket layout.
+		void Merge(const HistogramSnapshot &other) {
+			if (_counts.empty()) {
+				_subBuckets = other._subBuckets;
+			}
+			if (_counts.size() < other._counts.size()) {
+				_counts.resize(other._counts.size(), 0);
+			}
+			for (std::size_t i = 0; i < other._counts.size(); i++) {
+				_counts[i] += other._counts[i];
+			}
+			_count += other._count;
+			_sum += other._sum;
+			_min = std::min(_min, other._min);
+			_max = std::max(_max, other._max);
+		}
+
+		// Largest value that falls into bucket index.
+		uint64_t UpperBound(std::size_t index) const {
+			if (index < _subBuckets) {
+				return index;
+			}
+			const uint64_t shift = index / _subBuckets - 1;
+			const uint64_t base = _subBuckets + index % _subBuckets;
+			return ((base + 1) << shift) - 1;
+		}
+	};
+
+	// Log-linear histogram in the style of HdrHistogram: every power-of-two range is split into
+	// 2^SUB_BUCKET_BITS linear buckets, bounding the relative error of recorded values.
+	// Record is lock-free; Snapshot may run concurrently with writers.
+	template <std::size_t SUB_BUCKET_BITS = 4>
+	class Histogram {
+		static constexpr uint64_t SUB_BUCKETS = uint64_t{ 1 } << SUB_BUCKET_BITS;
+	public:
+		static constexpr std::size_t BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+	private:
+		std::array<std::atomic<uint64_t>, BUCKETS> _counts{};
+		std::atomic<uint64_t> _sum{ 0 };
+		std::atomic<uint64_t> _min{ std::numeric_limits<uint64_t>::max() };
+		std::atomic<uint64_t> _max{ 0 };
+	public:
+		static constexpr std::size_t IndexOf(uint64_t value) {
+			if (value < SUB_BUCKETS) {
+				return static_cast<std::size_t>(value);
+			}
+			const std::size_t shift = static_cast<std::size_t>(std::bit_width(value)) - SUB_BUCKET_BITS - 1;
+			return (shift + 1) * SUB_BUCKETS + static_cast<std::size_t>((value >> shift) - SUB_BUCKETS);
+		}
+
+		void Record(uint64_t value) {
+			_counts[IndexOf(value)].fetch_add(1, std::memory_order_relaxed);
+			_sum.fetch_add(value, std::memory_order_relaxed);
+			uint64_t current = _min.load(std::memory_order_relaxed);
+			while (value < current && !_min.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+			current = _max.load(std::memory_order_relaxed);
+			while (value > current && !_max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+		}
+
+		HistogramSnapshot Snapshot() const {
+			HistogramSnapshot snapshot;
+			snapshot._counts.resize(BUCKETS);
+			uint64_t count = 0;
+			for (std::size_t i = 0; i < BUCKETS; i++) {
+				snapshot._counts[i] = _counts[i].load(std::memory_order_relaxed);
+				count += snapshot._counts[i];
+			}
+			snapshot._count = count;
+			snapshot._sum = _sum.load(std::memory_order_relaxed);
+			snapshot._min = _min.load(std::memory_order_relaxed);
+			snapshot._max = _max.load(std::memory_order_relaxed);
+			snapshot._subBuckets = SUB_BUCKETS;
+			return snapshot;
+		}
+
+		// Not atomic with respect to concurrent Record calls.
+		void Reset() {
+			for (auto &count : _counts) {
+				count.store(0, std::memory_order_relaxed);
+			}
+			_sum.store(0, std::memory_order_relaxed);
+			_min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+			_max.store(0, std::memory_order_relaxed);
+		}
+	};
+
+	inline uint64_t HistogramSnapshot::Percentile(double percentile) const {
+		if (_count == 0) {
+			return 0;
+		}
+		const double clamped = std::clamp(percentile, 0.0, 100.0);
+		uint64_t rank = static_cast<uint64_t>(clamped / 100.0 * static_cast<double>(_count) + 0.5);
+		rank = std::clamp<uint64_t>(rank, 1, _count);
+		uint64_t seen = 0;
+		for (std::size_t i = 0; i < _counts.size(); i++) {
+			seen += _counts[i];
+			if (seen >= rank) {
+				return std::min(UpperBound(i), _max);
+			}
+		}
+		return _max;
+	}
+} // namespace Framework::Metrics
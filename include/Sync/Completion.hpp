@@ -0,0 +1,200 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Sync/Futex.hpp"
+#include "Templates/TypeId.hpp"
+
+namespace Framework::Sync {
+	template <typename T>
+	class CompletionPool;
+
+	template <typename V>
+	class TypedCompletion;
+
+	// One-shot response channel between a single waiter and a single completer.
+	// A waiter that times out abandons the slot; the completer then returns it to its pool,
+	// or frees it when the owning thread (and its pool) has already gone away.
+	class Completion {
+	public:
+		static constexpr auto WAIT_FOREVER = std::chrono::milliseconds::zero();
+	protected:
+		enum State : uint32_t {
+			FREE = 0,
+			PENDING,
+			COMPLETED,
+			ABANDONED,
+			ORPHANED,
+		};
+
+		std::atomic<uint32_t> _state{ FREE };
+		bool _response{ false };
+		std::exception_ptr _exception{};
+		const Templates::TypeId _resultType{ nullptr };
+
+		explicit Completion(Templates::TypeId resultType) : _resultType(resultType) {}
+
+		bool _TryAcquire() {
+			uint32_t expected = FREE;
+			return _state.compare_exchange_strong(expected, PENDING, std::memory_order_acquire);
+		}
+
+		bool _TryOrphan() {
+			uint32_t expected = ABANDONED;
+			return _state.compare_exchange_strong(expected, ORPHANED, std::memory_order_acq_rel);
+		}
+
+		virtual void _Reset() {
+			_exception = nullptr;
+		}
+
+		virtual void _Complete() {
+			uint32_t expected = PENDING;
+			if (_state.compare_exchange_strong(expected, COMPLETED, std::memory_order_acq_rel)) {
+				Futex::Wake(_state);
+				return;
+			}
+			_Reset();
+			expected = ABANDONED;
+			if (!_state.compare_exchange_strong(expected, FREE, std::memory_order_acq_rel)) {
+				delete this;
+			}
+		}
+
+		template <typename T>
+		friend class CompletionPool;
+	public:
+		Completion() = default;
+		Completion(const Completion &) = delete;
+		Completion &operator=(const Completion &) = delete;
+		virtual ~Completion() = default;
+
+		void Set(bool response) {
+			_response = response;
+			_Complete();
+		}
+
+		void HandleException() {
+			_exception = std::current_exception();
+			_Complete();
+		}
+
+		// Stores a typed result before completion; false when the waiter expects no result of type V.
+		template <typename V>
+		bool SetResult(V &&value);
+
+		// Runs deferred completion work on the thread that was asked to resume it.
+		virtual void Continue() {}
+
+		// Returns false on timeout; the slot is then abandoned and must not be touched again.
+		bool Wait(std::chrono::milliseconds timeout = WAIT_FOREVER) {
+			const auto deadline = std::chrono::steady_clock::now() + timeout;
+			while (true) {
+				if (_state.load(std::memory_order_acquire) == COMPLETED) {
+					return true;
+				}
+				auto remaining = WAIT_FOREVER;
+				if (timeout != WAIT_FOREVER) {
+					remaining = std::chrono::ceil<std::chrono::milliseconds>(
+						deadline - std::chrono::steady_clock::now());
+					if (remaining <= std::chrono::milliseconds::zero()) {
+						uint32_t expected = PENDING;
+						return !_state.compare_exchange_strong(expected, ABANDONED, std::memory_order_acq_rel);
+					}
+				}
+				Futex::Wait(_state, PENDING, remaining);
+			}
+		}
+
+		// Consumes a completed slot, returning it to the pool and rethrowing a handler exception.
+		bool GetResponse() {
+			std::exception_ptr exception = std::move(_exception);
+			const bool response = _response;
+			_Reset();
+			_state.store(FREE, std::memory_order_release);
+			if (exception) {
+				std::rethrow_exception(exception);
+			}
+			return response;
+		}
+
+		// Returns a slot that was acquired but never handed to a completer.
+		void Release() {
+			_Reset();
+			_state.store(FREE, std::memory_order_release);
+		}
+	};
+
+	template <typename V>
+	class TypedCompletion : public Completion {
+		std::optional<V> _result{};
+
+		void _Reset() override {
+			Completion::_Reset();
+			_result.reset();
+		}
+
+		friend class Completion;
+	public:
+		TypedCompletion() : Completion(Templates::TypeIdOf<V>()) {}
+
+		// Consumes a completed slot like GetResponse, also handing over the typed result.
+		std::pair<bool, std::optional<V>> GetResult() {
+			std::optional<V> result = std::move(_result);
+			const bool response = GetResponse();
+			return { response, std::move(result) };
+		}
+	};
+
+	template <typename V>
+	bool Completion::SetResult(V &&value) {
+		using Result = std::decay_t<V>;
+		if (_resultType != Templates::TypeIdOf<Result>()) {
+			return false;
+		}
+		static_cast<TypedCompletion<Result> *>(this)->_result.emplace(std::forward<V>(value));
+		return true;
+	}
+
+	template <typename T = Completion>
+	class CompletionPool {
+		std::vector<T *> _slots;
+	public:
+		CompletionPool() = default;
+		CompletionPool(const CompletionPool &) = delete;
+		CompletionPool &operator=(const CompletionPool &) = delete;
+
+		~CompletionPool() {
+			for (T *slot : _slots) {
+				if (!slot->_TryOrphan()) {
+					delete slot;
+				}
+			}
+		}
+
+		T *Acquire() {
+			for (T *slot : _slots) {
+				if (slot->_TryAcquire()) {
+					return slot;
+				}
+			}
+			T *slot = new T();
+			slot->_TryAcquire();
+			_slots.push_back(slot);
+			return slot;
+		}
+
+		// Acquires a slot from the calling thread's pool.
+		static T *AcquireLocal() {
+			thread_local CompletionPool pool;
+			return pool.Acquire();
+		}
+	};
+} // namespace Framework::Sync
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace Framework::Sync {
+	class Futex final {
+	public:
+		static constexpr auto WAIT_FOREVER = std::chrono::milliseconds::zero();
+
+		// Returns false only when the timeout expired; wake-ups may be spurious.
+		static bool Wait(std::atomic<uint32_t> &word, uint32_t expected,
+			std::chrono::milliseconds timeout = WAIT_FOREVER) {
+			return _Wait(word, expected, timeout, FUTEX_WAIT_PRIVATE);
+		}
+
+		static void Wake(std::atomic<uint32_t> &word, int count = 1) {
+			syscall(SYS_futex, _Address(word), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+		}
+
+		static void WakeAll(std::atomic<uint32_t> &word) {
+			Wake(word, INT_MAX);
+		}
+
+		// Variants for words in memory mapped by several processes.
+		static bool WaitShared(std::atomic<uint32_t> &word, uint32_t expected,
+			std::chrono::milliseconds timeout = WAIT_FOREVER) {
+			return _Wait(word, expected, timeout, FUTEX_WAIT);
+		}
+
+		static void WakeShared(std::atomic<uint32_t> &word, int count = 1) {
+			syscall(SYS_futex, _Address(word), FUTEX_WAKE, count, nullptr, nullptr, 0);
+		}
+
+		static void WakeAllShared(std::atomic<uint32_t> &word) {
+			WakeShared(word, INT_MAX);
+		}
+
+	private:
+		static bool _Wait(std::atomic<uint32_t> &word, uint32_t expected,
+			std::chrono::milliseconds timeout, int operation) {
+			timespec relative{};
+			timespec *relativePtr = nullptr;
+			if (timeout != WAIT_FOREVER) {
+				auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+				relative.tv_sec = static_cast<time_t>(seconds.count());
+				relative.tv_nsec = static_cast<long>(
+					std::chrono::duration_cast<std::chrono::nanoseconds>(timeout - seconds).count());
+				relativePtr = &relative;
+			}
+			long result = syscall(SYS_futex, _Address(word), operation,
+				expected, relativePtr, nullptr, 0);
+			return !(result == -1 && errno == ETIMEDOUT);
+		}
+
+		static uint32_t *_Address(std::atomic<uint32_t> &word) {
+			static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+			return reinterpret_cast<uint32_t *>(&word);
+		}
+	};
+} // namespace Framework::Sync
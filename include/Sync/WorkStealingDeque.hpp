@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace Framework::Sync {
+	// Chase-Lev deque: the owning thread pushes and takes at the bottom, any thread steals from the top.
+	// Push and Take must only be called by the owner. Buffers replaced on growth are kept until destruction,
+	// so a concurrent Steal never reads freed memory.
+	template <typename T>
+	class WorkStealingDeque {
+		static_assert(std::is_trivially_copyable_v<T>, "elements must be trivially copyable");
+	public:
+		static constexpr std::size_t DEFAULT_CAPACITY = 256;
+	private:
+		static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+		class _Buffer {
+			const int64_t _mask;
+			std::unique_ptr<std::atomic<T>[]> _elements;
+		public:
+			explicit _Buffer(int64_t capacity) :
+				_mask(capacity - 1), _elements(std::make_unique<std::atomic<T>[]>(capacity)) {}
+
+			int64_t Capacity() const { return _mask + 1; }
+
+			void Put(int64_t index, T value) {
+				_elements[index & _mask].store(value, std::memory_order_relaxed);
+			}
+
+			T Get(int64_t index) const {
+				return _elements[index & _mask].load(std::memory_order_relaxed);
+			}
+		};
+
+		alignas(CACHE_LINE_SIZE) std::atomic<int64_t> _top{ 0 };
+		alignas(CACHE_LINE_SIZE) std::atomic<int64_t> _bottom{ 0 };
+		std::atomic<_Buffer *> _buffer;
+		std::vector<std::unique_ptr<_Buffer>> _buffers;
+
+		_Buffer *_Grow(_Buffer *buffer, int64_t top, int64_t bottom) {
+			auto grown = std::make_unique<_Buffer>(buffer->Capacity() * 2);
+			for (int64_t i = top; i < bottom; i++) {
+				grown->Put(i, buffer->Get(i));
+			}
+			_Buffer *raw = grown.get();
+			_buffers.push_back(std::move(grown));
+			_buffer.store(raw, std::memory_order_release);
+			return raw;
+		}
+
+	public:
+		explicit WorkStealingDeque(std::size_t capacity = DEFAULT_CAPACITY) {
+			std::size_t rounded = 2;
+			while (rounded < capacity) {
+				rounded <<= 1;
+			}
+			_buffers.push_back(std::make_unique<_Buffer>(static_cast<int64_t>(rounded)));
+			_buffer.store(_buffers.back().get(), std::memory_order_relaxed);
+		}
+
+		WorkStealingDeque(const WorkStealingDeque &) = delete;
+		WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+
+		void Push(T value) {
+			int64_t bottom = _bottom.load(std::memory_order_relaxed);
+			int64_t top = _top.load(std::memory_order_acquire);
+			_Buffer *buffer = _buffer.load(std::memory_order_relaxed);
+			if (bottom - top > buffer->Capacity() - 1) {
+				buffer = _Grow(buffer, top, bottom);
+			}
+			buffer->Put(bottom, value);
+			std::atomic_thread_fence(std::memory_order_release);
+			_bottom.store(bottom + 1, std::memory_order_relaxed);
+		}
+
+		std::optional<T> Take() {
+			int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+			_Buffer *buffer = _buffer.load(std::memory_order_relaxed);
+			_bottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t top = _top.load(std::memory_order_relaxed);
+			if (top > bottom) {
+				_bottom.store(bottom + 1, std::memory_order_relaxed);
+				return std::nullopt;
+			}
+			T value = buffer->Get(bottom);
+			if (top == bottom) {
+				bool won = _top.compare_exchange_strong(top, top + 1,
+					std::memory_order_seq_cst, std::memory_order_relaxed);
+				_bottom.store(bottom + 1, std::memory_order_relaxed);
+				if (!won) {
+					return std::nullopt;
+				}
+			}
+			return value;
+		}
+
+		// May fail spuriously when racing with another thief or the owner; callers simply move on.
+		std::optional<T> Steal() {
+			int64_t top = _top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t bottom = _bottom.load(std::memory_order_acquire);
+			if (top >= bottom) {
+				return std::nullopt;
+			}
+			T value = _buffer.load(std::memory_order_acquire)->Get(top);
+			if (!_top.compare_exchange_strong(top, top + 1,
+				std::memory_order_seq_cst, std::memory_order_relaxed)) {
+				return std::nullopt;
+			}
+			return value;
+		}
+
+		std::size_t Size() const {
+			int64_t bottom = _bottom.load(std::memory_order_relaxed);
+			int64_t top = _top.load(std::memory_order_relaxed);
+			return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+		}
+
+		bool IsEmpty() const {
+			return Size() == 0;
+		}
+	};
+} // namespace Framework::Sync
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <utility>
+
+#include "Sync/Completion.hpp"
+#include "Task/RpcResult.hpp"
+
+namespace Framework::Task {
+	// Hands a completion back to the event task that issued the call; false when that task is gone.
+	using ContinuationPoster = std::function<bool(Sync::Completion *)>;
+
+	// Poster of the event task running on this thread, or nullptr outside event tasks.
+	inline const ContinuationPoster *&CurrentContinuationPoster() {
+		thread_local const ContinuationPoster *poster = nullptr;
+		return poster;
+	}
+
+	// Receives exceptions that escape asynchronous work: coroutine handlers and RpcEventAsync callbacks.
+	using ErrorSink = std::function<void(std::exception_ptr)>;
+
+	// Sink of the event task running on this thread, or nullptr outside event tasks.
+	inline const ErrorSink *&CurrentErrorSink() {
+		thread_local const ErrorSink *sink = nullptr;
+		return sink;
+	}
+
+	// Hands exception to the sink of the event task on this thread; without one it is written to stderr.
+	inline void ReportAsyncError(std::exception_ptr exception) noexcept {
+		try {
+			if (const ErrorSink *sink = CurrentErrorSink(); sink && *sink) {
+				(*sink)(exception);
+				return;
+			}
+			std::rethrow_exception(exception);
+		} catch (const std::exception &e) {
+			std::cerr << "Unhandled exception in asynchronous event work: " << e.what() << std::endl;
+		} catch (...) {
+			std::cerr << "Unhandled exception in asynchronous event work" << std::endl;
+		}
+	}
+
+	// Completion of an asynchronous RPC. The callback runs on the calling event task's thread
+	// when the call was issued from one, otherwise on the thread that completed the request.
+	template <typename V>
+	class AsyncCompletion : public Sync::TypedCompletion<V> {
+		std::function<void(RpcResult<V>)> _callback;
+		ContinuationPoster _home;
+
+		void _Complete() override {
+			if (_home && _home(this)) {
+				return;
+			}
+			Continue();
+		}
+
+		RpcResult<V> _TakeResult() {
+			try {
+				auto [handled, value] = this->GetResult();
+				return RpcResult<V>::FromResponse(handled, std::move(value));
+			} catch (...) {
+				return RpcResult<V>{ std::current_exception() };
+			}
+		}
+	public:
+		explicit AsyncCompletion(std::function<void(RpcResult<V>)> &&callback) :
+			_callback(std::move(callback)) {
+			if (const ContinuationPoster *home = CurrentContinuationPoster()) {
+				_home = *home;
+			}
+		}
+
+		void Continue() override {
+			RpcResult<V> result = _TakeResult();
+			auto callback = std::move(_callback);
+			delete this;
+			try {
+				callback(std::move(result));
+			} catch (...) {
+				ReportAsyncError(std::current_exception());
+			}
+		}
+	};
+
+	// Fire-and-forget coroutine for handlers that co_await RpcEventAsync.
+	// Handler arguments must be copied before the first co_await; they do not outlive the handler.
+	// An exception leaving the coroutine goes to ReportAsyncError.
+	class AsyncHandler {
+	public:
+		struct promise_type {
+			AsyncHandler get_return_object() noexcept { return {}; }
+			std::suspend_never initial_suspend() noexcept { return {}; }
+			std::suspend_never final_suspend() noexcept { return {}; }
+			void return_void() noexcept {}
+			void unhandled_exception() noexcept { ReportAsyncError(std::current_exception()); }
+		};
+	};
+} // namespace Framework::Task
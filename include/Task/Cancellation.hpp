@@ -0,0 +1,40 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+namespace Framework::Task {
+	// Read side of a cancellation flag; a default-constructed token is never cancelled.
+	class CancellationToken {
+		std::shared_ptr<const std::atomic<bool>> _cancelled{};
+	public:
+		CancellationToken() = default;
+		explicit CancellationToken(std::shared_ptr<const std::atomic<bool>> cancelled) :
+			_cancelled(std::move(cancelled)) {}
+
+		bool IsCancelled() const {
+			return _cancelled && _cancelled->load(std::memory_order_acquire);
+		}
+
+		bool CanBeCancelled() const {
+			return _cancelled != nullptr;
+		}
+	};
+
+	// Owner side: Cancel is observed by every token handed out, before or after the call.
+	class CancellationSource {
+		std::shared_ptr<std::atomic<bool>> _cancelled{ std::make_shared<std::atomic<bool>>(false) };
+	public:
+		CancellationToken GetToken() const {
+			return CancellationToken{ _cancelled };
+		}
+
+		void Cancel() {
+			_cancelled->store(true, std::memory_order_release);
+		}
+
+		bool IsCancelled() const {
+			return _cancelled->load(std::memory_order_acquire);
+		}
+	};
+} // namespace Framework::Task
@@ -0,0 +1,112 @@
+#pragma once
+#include <sched.h>
+#include <pthread.h>
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace Framework::Task {
+	// CPUs this process may run on, grouped by NUMA node as reported under /sys/devices/system/node.
+	class CpuTopology final {
+		std::vector<int> _cpus{};
+		std::vector<int> _nodes{};
+		std::size_t _nodeCount{ 1 };
+	public:
+		static constexpr const char *NODE_ROOT = "/sys/devices/system/node";
+
+		// Parses the kernel's cpulist format, e.g. "0-3,8,10-11".
+		static std::vector<int> ParseCpuList(const std::string &list) {
+			std::vector<int> cpus;
+			std::stringstream stream(list);
+			std::string range;
+			while (std::getline(stream, range, ',')) {
+				if (range.empty() || range == "\n") {
+					continue;
+				}
+				auto dash = range.find('-');
+				int first = std::atoi(range.substr(0, dash).c_str());
+				int last = dash == std::string::npos ? first : std::atoi(range.substr(dash + 1).c_str());
+				for (int cpu = first; cpu <= last; cpu++) {
+					cpus.push_back(cpu);
+				}
+			}
+			return cpus;
+		}
+
+		// Without NUMA information in root, every CPU is reported on node 0.
+		static CpuTopology Detect(const std::string &root = NODE_ROOT) {
+			cpu_set_t cpu_set;
+			CPU_ZERO(&cpu_set);
+			pthread_getaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+			std::vector<int> allowed;
+			for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+				if (CPU_ISSET(cpu, &cpu_set)) {
+					allowed.push_back(cpu);
+				}
+			}
+			return CpuTopology(allowed, _ReadNodes(root));
+		}
+
+		// nodes[i] lists the CPUs of node i; CPUs missing from it are placed on node 0.
+		CpuTopology(const std::vector<int> &allowed, const std::vector<std::vector<int>> &nodes) {
+			int maxCpu = allowed.empty() ? -1 : *std::max_element(allowed.begin(), allowed.end());
+			_nodes.assign(static_cast<std::size_t>(maxCpu + 1), 0);
+			for (std::size_t node = 0; node < nodes.size(); node++) {
+				for (int cpu : nodes[node]) {
+					if (cpu <= maxCpu) {
+						_nodes[cpu] = static_cast<int>(node);
+					}
+				}
+			}
+			_cpus = allowed;
+			std::stable_sort(_cpus.begin(), _cpus.end(), [this](int a, int b) {
+				return _nodes[a] < _nodes[b];
+			});
+			_nodeCount = std::max<std::size_t>(nodes.size(), 1);
+		}
+
+		const std::vector<int> &Cpus() const { return _cpus; }
+		std::size_t CountNodes() const { return _nodeCount; }
+
+		int NodeOf(int cpu) const {
+			return cpu >= 0 && static_cast<std::size_t>(cpu) < _nodes.size() ? _nodes[cpu] : 0;
+		}
+
+		// CPUs of node that this process may use.
+		std::vector<int> CpusOf(int node) const {
+			std::vector<int> cpus;
+			for (int cpu : _cpus) {
+				if (NodeOf(cpu) == node) {
+					cpus.push_back(cpu);
+				}
+			}
+			return cpus;
+		}
+
+	private:
+		static std::vector<std::vector<int>> _ReadNodes(const std::string &root) {
+			std::vector<std::vector<int>> nodes;
+			std::error_code error;
+			for (const auto &entry : std::filesystem::directory_iterator(root, error)) {
+				const std::string name = entry.path().filename().string();
+				if (name.rfind("node", 0) != 0 || name.size() == 4 ||
+					name.find_first_not_of("0123456789", 4) != std::string::npos) {
+					continue;
+				}
+				std::size_t node = std::stoul(name.substr(4));
+				std::ifstream file(entry.path() / "cpulist");
+				std::string list;
+				std::getline(file, list);
+				if (nodes.size() <= node) {
+					nodes.resize(node + 1);
+				}
+				nodes[node] = ParseCpuList(list);
+			}
+			return nodes;
+		}
+	};
+} // namespace Framework::Task
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Task/EventRequest.hpp"
+#include "Task/interface/IMessageTask.hpp"
+
+namespace Framework::Task {
+	// Topic-based fan-out between tasks: a task subscribes to an inclusive range of commands and each
+	// published request is sent to every subscribed task once. Publishing copies the request per
+	// subscriber, so a SharedPayload (EventRequest<T, SharedPayload>) keeps fan-out to a reference
+	// count. Subscribed tasks must be unsubscribed before they are destroyed. Unsubscribe returns once
+	// no publish still running can reach the dropped tasks, so it must not be called from a handler
+	// of a task that a concurrent Publish may be blocked sending to.
+	template <typename T = EventRequest<>::Command, typename R = EventRequest<T>>
+	class EventBus final {
+		static_assert(std::is_copy_constructible_v<R>, "published requests are copied to each subscriber");
+	public:
+		using Command = T;
+		using Task = IEventTask<T, R>;
+		using Subscription = uint64_t;
+	private:
+		struct _Subscriber {
+			Subscription id;
+			Task *task;
+			Command first;
+			Command last;
+
+			bool Accepts(Command command) const { return !(command < first) && !(last < command); }
+		};
+		using _Subscribers = std::vector<_Subscriber>;
+
+		// Replaced, never modified, so Publish can fan out from it without a lock. publishing counts
+		// the publishes fanning out from this snapshot.
+		struct _Snapshot {
+			_Subscribers subscribers{};
+			mutable std::atomic<std::size_t> publishing{ 0 };
+		};
+
+		std::atomic<std::shared_ptr<const _Snapshot>> _current{ std::make_shared<const _Snapshot>() };
+		// Guards updates. _replaced holds the earlier snapshots a publish may still be using.
+		std::mutex _mutex{};
+		Subscription _nextId{ 1 };
+		std::vector<std::weak_ptr<const _Snapshot>> _replaced{};
+
+		// Joins the current snapshot. A publish that joins a snapshot already replaced leaves and tries
+		// again, so a removal that sees no publish on the snapshots it replaced cannot miss one.
+		class _Publication {
+			std::shared_ptr<const _Snapshot> _snapshot;
+
+			void _Leave() {
+				if (_snapshot->publishing.fetch_sub(1) == 1) {
+					_snapshot->publishing.notify_all();
+				}
+			}
+		public:
+			explicit _Publication(const EventBus &bus) {
+				while (true) {
+					_snapshot = bus._current.load();
+					_snapshot->publishing.fetch_add(1);
+					if (bus._current.load() == _snapshot) {
+						return;
+					}
+					_Leave();
+				}
+			}
+			_Publication(const _Publication &) = delete;
+			_Publication &operator=(const _Publication &) = delete;
+
+			~_Publication() { _Leave(); }
+
+			const _Subscribers &Subscribers() const { return _snapshot->subscribers; }
+		};
+
+		template <typename F>
+		void _Update(F &&update) {
+			std::lock_guard<std::mutex> lock(_mutex);
+			_Replace(std::forward<F>(update));
+		}
+
+		template <typename F>
+		void _Replace(F &&update) {
+			auto current = _current.load();
+			auto snapshot = std::make_shared<_Snapshot>();
+			snapshot->subscribers = current->subscribers;
+			update(snapshot->subscribers);
+			_current.store(std::move(snapshot));
+			std::erase_if(_replaced, [](const auto &replaced) { return replaced.expired(); });
+			_replaced.push_back(std::move(current));
+		}
+
+		// Drops subscribers, then waits for the publishes that started from an earlier snapshot.
+		template <typename F>
+		void _Remove(F &&update) {
+			std::vector<std::shared_ptr<const _Snapshot>> replaced;
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_Replace(std::forward<F>(update));
+				for (const auto &snapshot : _replaced) {
+					if (auto locked = snapshot.lock()) {
+						replaced.push_back(std::move(locked));
+					}
+				}
+			}
+			for (const auto &snapshot : replaced) {
+				for (auto publishing = snapshot->publishing.load(); publishing != 0;
+					publishing = snapshot->publishing.load()) {
+					snapshot->publishing.wait(publishing);
+				}
+			}
+		}
+
+		// A task subscribed more than once is matched by its first accepting subscription only.
+		static bool _Matches(const _Subscribers &subscribers, std::size_t index, Command command) {
+			const _Subscriber &subscriber = subscribers[index];
+			if (!subscriber.Accepts(command)) {
+				return false;
+			}
+			for (std::size_t i = 0; i < index; i++) {
+				if (subscribers[i].task == subscriber.task && subscribers[i].Accepts(command)) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		// Every matched task is tried; the first failure is rethrown once all have been.
+		template <typename Request>
+		static std::size_t _Deliver(const _Subscribers &subscribers, Request &&request) {
+			const Command command = request.GetCommand();
+			std::size_t last = subscribers.size();
+			while (last != 0 && !_Matches(subscribers, last - 1, command)) {
+				last--;
+			}
+			std::size_t delivered = 0;
+			std::exception_ptr failure;
+			for (std::size_t i = 0; i < last; i++) {
+				if (!_Matches(subscribers, i, command)) {
+					continue;
+				}
+				try {
+					if (i + 1 == last && std::is_rvalue_reference_v<Request &&>) {
+						subscribers[i].task->SendEvent(std::move(request));
+					} else {
+						subscribers[i].task->SendEvent(std::as_const(request));
+					}
+					delivered++;
+				} catch (...) {
+					if (!failure) {
+						failure = std::current_exception();
+					}
+				}
+			}
+			if (failure) {
+				std::rethrow_exception(failure);
+			}
+			return delivered;
+		}
+	public:
+		EventBus() = default;
+		EventBus(const EventBus &) = delete;
+		EventBus &operator=(const EventBus &) = delete;
+
+		Subscription Subscribe(Task &task, Command first, Command last) {
+			Subscription id;
+			_Update([&](_Subscribers &subscribers) {
+				id = _nextId++;
+				subscribers.push_back({ id, &task, first, last });
+			});
+			return id;
+		}
+
+		Subscription Subscribe(Task &task, Command command) {
+			return Subscribe(task, command, command);
+		}
+
+		void Unsubscribe(Subscription id) {
+			_Remove([id](_Subscribers &subscribers) {
+				std::erase_if(subscribers, [id](const _Subscriber &subscriber) { return subscriber.id == id; });
+			});
+		}
+
+		// Drops every subscription of task.
+		void Unsubscribe(Task &task) {
+			_Remove([&task](_Subscribers &subscribers) {
+				std::erase_if(subscribers, [&task](const _Subscriber &subscriber) { return subscriber.task == &task; });
+			});
+		}
+
+		// Returns the number of tasks the request was sent to. The last one receives it by move.
+		std::size_t Publish(R &&request) {
+			_Publication publication(*this);
+			return _Deliver(publication.Subscribers(), std::move(request));
+		}
+
+		std::size_t Publish(const R &request) {
+			_Publication publication(*this);
+			return _Deliver(publication.Subscribers(), request);
+		}
+
+		std::size_t CountSubscribers(Command command) const {
+			const auto snapshot = _current.load();
+			std::size_t count = 0;
+			for (std::size_t i = 0; i < snapshot->subscribers.size(); i++) {
+				if (_Matches(snapshot->subscribers, i, command)) {
+					count++;
+				}
+			}
+			return count;
+		}
+	};
+} // namespace Framework::Task
@@ -2,53 +2,82 @@
 
 #include <string>
 #include <any>
+#include <type_traits>
 #include "Exception/Exception.hpp"
+#include "Task/TaskRegistry.hpp"
 
 namespace Framework::Task {
 
-	template <typename T = int64_t>
+	template <typename T = int64_t, typename P = std::any, typename F = std::string>
 	class EventRequest {
 	public:
 		using Command = T;
+		using Payload = P;
+		using From = F;
 	private:
-		std::string _from;
+		static constexpr bool _IS_ANY = std::is_same_v<Payload, std::any>;
+
+		From _from;
 		Command _command { 0 };
-		std::any _payload;
+		Payload _payload;
 	public:
 		EventRequest() = default;
-		EventRequest(const std::string &from, Command command, const std::any &payload) :
+		EventRequest(const From &from, Command command, const Payload &payload) :
 			_from(from), _command(command), _payload(payload) {}
-		EventRequest(const std::string &from, Command command, std::any &&payload) :
+		EventRequest(const From &from, Command command, Payload &&payload) :
 			_from(from), _command(command), _payload(std::move(payload)) {}
-		EventRequest(const std::string &from, Command command) :
+		EventRequest(const From &from, Command command) :
 			_from(from), _command(command) {}
-		EventRequest(const EventRequest &other) :
-			_from(other._from), _command(other._command) {
-			if (other.HasPayload())
-				_payload = other._payload;
-		}
-		EventRequest(EventRequest &&other) :
-			_from(std::move(other._from)), _command(other._command), _payload(std::move(other._payload)) {}
-
-		EventRequest &operator=(const EventRequest &other) {
-			if (this != &other) {
-				_from = other._from;
-				_command = other._command;
-				if (other.HasPayload())
-					_payload = other._payload;
+		EventRequest(const EventRequest &other) = default;
+		EventRequest(EventRequest &&other) noexcept = default;
+
+		EventRequest &operator=(const EventRequest &other) = default;
+		EventRequest &operator=(EventRequest &&other) noexcept = default;
+
+		const From &GetFrom() const { return _from; }
+
+		std::string GetFromName() const {
+			if constexpr (std::is_same_v<From, TaskId>) {
+				return TaskRegistry::Resolve(_from);
+			} else {
+				return _from;
 			}
-			return *this;
 		}
 
-		const std::string &GetFrom() const { return _from; }
-
 		Command GetCommand() const { return _command; }
 
-		bool HasPayload() const { return _payload.has_value(); }
-		const std::any &GetPayload() const { return _payload; }
+		bool HasPayload() const {
+			if constexpr (_IS_ANY) {
+				return _payload.has_value();
+			} else {
+				return _payload.HasValue();
+			}
+		}
+		const Payload &GetPayload() const { return _payload; }
 		template <typename U>
 		const U &GetPayloadAs() const {
-			return std::any_cast<const U&>(_payload);
+			if constexpr (_IS_ANY) {
+				return std::any_cast<const U&>(_payload);
+			} else {
+				return _payload.template As<U>();
+			}
 		}
 	};
+
+	template <typename T, typename U>
+	EventRequest(const std::string &, T, U) -> EventRequest<T>;
+	template <typename T>
+	EventRequest(const std::string &, T) -> EventRequest<T>;
+	template <typename T, typename U>
+	EventRequest(const char *, T, U) -> EventRequest<T>;
+	template <typename T>
+	EventRequest(const char *, T) -> EventRequest<T>;
+	template <typename T, typename U>
+	EventRequest(TaskId, T, U) -> EventRequest<T, std::any, TaskId>;
+	template <typename T>
+	EventRequest(TaskId, T) -> EventRequest<T, std::any, TaskId>;
+
+	// Carries the sender as an interned TaskId instead of a copied name.
+	template <typename T = int64_t, typename P = std::any>
+	using TaskEventRequest = EventRequest<T, P, TaskId>;
 } // namespace Framework::Task
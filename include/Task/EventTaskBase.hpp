@@ -1,41 +1,74 @@
 #pragma once
 
+#include <map>
+#include <optional>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
 #include <thread>
-#include <future>
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <vector>
 #include <string>
+#include <algorithm>
+
+#include "Metrics/Histogram.hpp"
 
 #include "Templates/EnumBitset.hpp"
 
+#include "Task/AsyncRpc.hpp"
 #include "Task/EventRequest.hpp"
+#include "Task/RpcResult.hpp"
+#include "Task/TaskPool.hpp"
+#include "Task/PriorityTaskQueue.hpp"
 #include "Task/interface/IMessageTask.hpp"
 #include "Task/interface/IEventAggregator.hpp"
 
 #include "Message/IMessageQueue.hpp"
 #include "Message/MessageQueueFactory.hpp"
 
+#include "Sync/Completion.hpp"
+#include "Sync/Futex.hpp"
+
 namespace Framework::Task {
 	using namespace Framework;
 
-	template <typename T = EventRequest<>::Command>
+	template <typename T = EventRequest<>::Command, typename R = EventRequest<T>>
 	class MessageEventArgs {
-		const EventRequest<T> *_content{ nullptr };
+		const R *_content{ nullptr };
+		Sync::Completion *_response{ nullptr };
 	public:
-		MessageEventArgs(const EventRequest<T> *content) : _content(content) {}
+		MessageEventArgs(const R *content, Sync::Completion *response = nullptr) :
+			_content(content), _response(response) {}
+
+		const R &GetRequest() const { return *_content; }
 
-		const EventRequest<T> &GetRequest() const { return *_content; }
+		// Hands a value back to a typed RpcEvent<V>; false when the caller is not waiting for a V.
+		template <typename V>
+		bool SetResult(V &&value) const {
+			return _response && _response->SetResult(std::forward<V>(value));
+		}
 	};
 
-	template <typename T = EventRequest<>::Command>
-	class EventTaskBase : public IEventTask<T>, TaskBase {
+	template <typename R>
+	MessageEventArgs(const R *) -> MessageEventArgs<typename R::Command, R>;
+	template <typename R>
+	MessageEventArgs(const R *, Sync::Completion *) -> MessageEventArgs<typename R::Command, R>;
+
+	template <typename T = EventRequest<>::Command, typename R = EventRequest<T>>
+	class EventTaskBase : public IEventTask<T, R>, TaskBase {
 	public:
 		using EventAggregator =
-			IEventAggregator<typename EventRequest<T>::Command, const MessageEventArgs<T> &>;
+			IEventAggregator<typename R::Command, const MessageEventArgs<T, R> &>;
 	private:
-		using _EventRequest = EventRequest<T>;
+		using _EventRequest = R;
 		using Command = _EventRequest::Command;
-		static constexpr std::chrono::milliseconds WAIT_FOREVER = IEventTask<T>::WAIT_FOREVER;
+		static constexpr std::chrono::milliseconds WAIT_FOREVER = IEventTask<T, R>::WAIT_FOREVER;
+		static constexpr bool _IS_COPYABLE = std::is_copy_constructible_v<_EventRequest>;
+		static constexpr std::size_t ACTOR_BUDGET = 64;
 
 		class Attribute final {
 		public:
@@ -43,6 +76,9 @@ namespace Framework::Task {
 				NONE = 0,
 				INTERNAL,
 				EXTERNAL,
+				CONTINUATION,
+				COALESCED,
+				WAKE,
 			};
 		private:
 			Type _type{ NONE };
@@ -51,16 +87,12 @@ namespace Framework::Task {
 			Attribute(Type flags) : _type(flags) {}
 			bool IsInternal() const { return _type == INTERNAL; }
 			bool IsExternal() const { return _type == EXTERNAL; }
+			bool IsContinuation() const { return _type == CONTINUATION; }
+			bool IsCoalesced() const { return _type == COALESCED; }
+			bool IsWake() const { return _type == WAKE; }
 		};
 
-		class Response final {
-			std::promise<bool> _response;
-		public:
-			std::future<bool> GetFuture() { return _response.get_future(); }
-
-			void Set(bool response) { _response.set_value(response); }
-			void HandleException() { _response.set_exception(std::current_exception()); }
-		};
+		using Response = Sync::Completion;
 
 		class InternalCommands final {
 		public:
@@ -71,113 +103,596 @@ namespace Framework::Task {
 		class MessageContent {
 			Attribute _attribute{};
 			_EventRequest _request{};
-			std::shared_ptr<Response> _response{ nullptr };
+			Response *_response{ nullptr };
+			TaskPriority _priority{ TaskPriority::NORMAL };
+			std::chrono::steady_clock::time_point _enqueued{};
 		public:
 			MessageContent() = default;
-			MessageContent(Attribute attribute, const _EventRequest &request, std::shared_ptr<Response> response = nullptr) :
+			MessageContent(Attribute attribute, const _EventRequest &request, Response *response = nullptr) :
 				_attribute(attribute), _request(request), _response(response) {}
-			MessageContent(Attribute attribute, _EventRequest &&request, std::shared_ptr<Response> response = nullptr) :
+			MessageContent(Attribute attribute, _EventRequest &&request, Response *response = nullptr) :
 				_attribute(attribute), _request(std::move(request)), _response(response) {}
 
 			const auto &GetAttribute() const { return _attribute; }
 			const auto &GetRequest() const { return _request; }
-			auto &GetResponseBuffer() const { return _response; }
+			Response *GetResponseBuffer() const { return _response; }
 			bool IsResponseRequired() const { return _response != nullptr; }
+			TaskPriority GetPriority() const { return _priority; }
+			void SetPriority(TaskPriority priority) { _priority = priority; }
+
+			// Left at the epoch unless mailbox metrics were enabled when the message was sent.
+			auto GetEnqueued() const { return _enqueued; }
+			void Stamp(std::chrono::steady_clock::time_point enqueued = std::chrono::steady_clock::now()) {
+				_enqueued = enqueued;
+			}
 		};
 
 		using MessageQueue = Message::IMessageQueue<MessageContent>;
 
+		// Puts HIGH and LOW messages in side lanes around the mailbox: HIGH ones are received before
+		// anything in the mailbox, LOW ones only once it is empty. Sending to a lane while the mailbox
+		// is empty also queues a WAKE marker for a consumer blocked on it; markers are never returned.
+		class _LanedMailbox final : public MessageQueue {
+			struct _Lane {
+				std::deque<MessageContent> messages{};
+				std::atomic<std::size_t> size{ 0 };
+			};
+
+			std::shared_ptr<MessageQueue> _queue;
+			std::mutex _laneMutex{};
+			_Lane _high{};
+			_Lane _low{};
+
+			std::optional<MessageContent> _Pop(_Lane &lane) {
+				if (lane.size.load(std::memory_order_relaxed) == 0) {
+					return std::nullopt;
+				}
+				std::lock_guard<std::mutex> lock(_laneMutex);
+				if (lane.messages.empty()) {
+					return std::nullopt;
+				}
+				MessageContent content = std::move(lane.messages.front());
+				lane.messages.pop_front();
+				lane.size.fetch_sub(1, std::memory_order_relaxed);
+				return content;
+			}
+
+			// mailboxEmpty: the caller just found the mailbox empty, so a LOW message may go.
+			std::optional<MessageContent> _PopLane(bool mailboxEmpty) {
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if (auto content = _Pop(_high)) {
+					return content;
+				}
+				if (_low.size.load(std::memory_order_relaxed) != 0 && (mailboxEmpty || _queue->IsEmpty())) {
+					return _Pop(_low);
+				}
+				return std::nullopt;
+			}
+
+			void _SendToLane(MessageContent &&message) {
+				_Lane &lane = message.GetPriority() == TaskPriority::HIGH ? _high : _low;
+				{
+					std::lock_guard<std::mutex> lock(_laneMutex);
+					lane.messages.push_back(std::move(message));
+					lane.size.fetch_add(1, std::memory_order_relaxed);
+				}
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if (_queue->IsEmpty()) {
+					_queue->Send({ Attribute::WAKE, _EventRequest{} });
+				}
+			}
+		public:
+			explicit _LanedMailbox(std::shared_ptr<MessageQueue> queue) : _queue(std::move(queue)) {}
+
+			using MessageQueue::Send;
+
+			void Send(MessageContent &&message) override {
+				if (message.GetPriority() == TaskPriority::NORMAL) {
+					_queue->Send(std::move(message));
+				} else {
+					_SendToLane(std::move(message));
+				}
+			}
+
+			bool TrySend(MessageContent &&message) override {
+				if (message.GetPriority() == TaskPriority::NORMAL) {
+					return _queue->TrySend(std::move(message));
+				}
+				_SendToLane(std::move(message));
+				return true;
+			}
+
+			MessageContent Receive() override {
+				while (true) {
+					if (auto content = _PopLane(false)) {
+						return std::move(*content);
+					}
+					MessageContent content = _queue->Receive();
+					if (!content.GetAttribute().IsWake()) {
+						return content;
+					}
+				}
+			}
+
+			std::pair<bool, MessageContent> TryReceive() override {
+				while (true) {
+					if (auto content = _PopLane(false)) {
+						return { true, std::move(*content) };
+					}
+					auto received = _queue->TryReceive();
+					if (!received.first) {
+						auto content = _PopLane(true);
+						return content ? std::pair{ true, std::move(*content) } : std::pair{ false, MessageContent{} };
+					}
+					if (!received.second.GetAttribute().IsWake()) {
+						return received;
+					}
+				}
+			}
+
+			std::pair<bool, MessageContent> TimedReceive(const std::chrono::milliseconds milliSec) override {
+				const auto deadline = std::chrono::steady_clock::now() + milliSec;
+				while (true) {
+					if (auto content = _PopLane(false)) {
+						return { true, std::move(*content) };
+					}
+					auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+					auto received = _queue->TimedReceive(std::max(remaining, std::chrono::milliseconds::zero()));
+					if (!received.first) {
+						auto content = _PopLane(true);
+						return content ? std::pair{ true, std::move(*content) } : std::pair{ false, MessageContent{} };
+					}
+					if (!received.second.GetAttribute().IsWake()) {
+						return received;
+					}
+				}
+			}
+
+			std::size_t ReceiveBatch(std::deque<MessageContent> &messages, std::size_t maxCount,
+				const std::chrono::milliseconds milliSec = std::chrono::milliseconds::zero()) override {
+				while (true) {
+					std::size_t count = 0;
+					while (count < maxCount) {
+						auto content = _PopLane(false);
+						if (!content) {
+							break;
+						}
+						messages.push_back(std::move(*content));
+						count++;
+					}
+					if (count != 0) {
+						return count;
+					}
+					const std::size_t first = messages.size();
+					if (_queue->ReceiveBatch(messages, maxCount, milliSec) == 0) {
+						return 0;
+					}
+					auto end = std::remove_if(messages.begin() + static_cast<std::ptrdiff_t>(first), messages.end(),
+						[](const MessageContent &content) { return content.GetAttribute().IsWake(); });
+					messages.erase(end, messages.end());
+					if (messages.size() != first) {
+						return messages.size() - first;
+					}
+				}
+			}
+
+			bool IsEmpty() override {
+				return _high.size.load(std::memory_order_relaxed) == 0 &&
+					_low.size.load(std::memory_order_relaxed) == 0 && _queue->IsEmpty();
+			}
+
+			void Clear() override {
+				{
+					std::lock_guard<std::mutex> lock(_laneMutex);
+					_high.messages.clear();
+					_high.size.store(0, std::memory_order_relaxed);
+					_low.messages.clear();
+					_low.size.store(0, std::memory_order_relaxed);
+				}
+				_queue->Clear();
+			}
+
+			std::size_t NumMessages() override {
+				return _high.size.load(std::memory_order_relaxed) + _low.size.load(std::memory_order_relaxed) +
+					_queue->NumMessages();
+			}
+		};
+
+		// Mailbox of a task run on an executor. The send that finds it idle schedules a drain;
+		// the flag then stays set until that drain gives the mailbox up, so drains never overlap.
+		class _ActorMailbox final : public MessageQueue {
+			std::shared_ptr<MessageQueue> _queue;
+			const std::function<void()> _schedule;
+			std::atomic<bool> _scheduled{ false };
+
+			void _Notify() {
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if (!_scheduled.load(std::memory_order_relaxed) &&
+					!_scheduled.exchange(true, std::memory_order_acq_rel)) {
+					_schedule();
+				}
+			}
+		public:
+			_ActorMailbox(std::shared_ptr<MessageQueue> queue, std::function<void()> schedule) :
+				_queue(std::move(queue)), _schedule(std::move(schedule)) {}
+
+			using MessageQueue::Send;
+
+			void Send(MessageContent &&message) override {
+				_queue->Send(std::move(message));
+				_Notify();
+			}
+
+			bool TrySend(MessageContent &&message) override {
+				if (!_queue->TrySend(std::move(message))) {
+					return false;
+				}
+				_Notify();
+				return true;
+			}
+
+			MessageContent Receive() override { return _queue->Receive(); }
+			std::pair<bool, MessageContent> TryReceive() override { return _queue->TryReceive(); }
+
+			std::pair<bool, MessageContent> TimedReceive(const std::chrono::milliseconds milliSec) override {
+				return _queue->TimedReceive(milliSec);
+			}
+
+			std::size_t ReceiveBatch(std::deque<MessageContent> &messages, std::size_t maxCount,
+				const std::chrono::milliseconds milliSec = std::chrono::milliseconds::zero()) override {
+				return _queue->ReceiveBatch(messages, maxCount, milliSec);
+			}
+
+			bool IsEmpty() override { return _queue->IsEmpty(); }
+			void Clear() override { _queue->Clear(); }
+			std::size_t NumMessages() override { return _queue->NumMessages(); }
+
+			// Called by the drain that found the mailbox empty. False when a send raced in;
+			// the caller then still owns the mailbox and must keep draining.
+			bool Release() {
+				_scheduled.store(false, std::memory_order_seq_cst);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				return _queue->IsEmpty() || _scheduled.exchange(true, std::memory_order_acq_rel);
+			}
+		};
+
 		class Sender {
 			std::weak_ptr<MessageQueue> _messageQueue;
-			std::shared_ptr<Response> _response{ nullptr };
+			Response *_response{ nullptr };
+			bool _stamp{ false };
 			bool sent{ false };
 		public:
-			Sender(const std::shared_ptr<MessageQueue> &messageQueue, bool needResponse = false) :
-				_messageQueue(messageQueue), _response(needResponse ? std::make_shared<Response>() : nullptr) {}
+			Sender(const std::shared_ptr<MessageQueue> &messageQueue, Response *response = nullptr, bool stamp = false) :
+				_messageQueue(messageQueue), _response(response), _stamp(stamp) {}
+
+			Sender(const Sender &) = delete;
+			Sender &operator=(const Sender &) = delete;
+
+			~Sender() {
+				if (_response && !sent) {
+					_response->Release();
+				}
+			}
 
-			void Send(Attribute attribute, const _EventRequest &request) {
+			void Send(Attribute attribute, const _EventRequest &request, TaskPriority priority = TaskPriority::NORMAL) {
 				if (auto messageQueue = _messageQueue.lock()) {
-					messageQueue->Send({ attribute, request, _response });
+					MessageContent content{ attribute, request, _response };
+					content.SetPriority(priority);
+					if (_stamp) content.Stamp();
+					messageQueue->Send(std::move(content));
 					sent = true;
 				}
 			}
 
+			void Send(Attribute attribute, _EventRequest &&request, TaskPriority priority = TaskPriority::NORMAL) {
+				if (auto messageQueue = _messageQueue.lock()) {
+					MessageContent content{ attribute, std::move(request), _response };
+					content.SetPriority(priority);
+					if (_stamp) content.Stamp();
+					messageQueue->Send(std::move(content));
+					sent = true;
+				}
+			}
+
+			// False when a FAIL mailbox is full; the request is then dropped.
+			bool TrySend(Attribute attribute, _EventRequest &&request) {
+				if (auto messageQueue = _messageQueue.lock()) {
+					MessageContent content{ attribute, std::move(request), _response };
+					if (_stamp) content.Stamp();
+					sent = messageQueue->TrySend(std::move(content));
+				}
+				return sent;
+			}
+
 			bool WaitForResponse(std::chrono::milliseconds timeoutMsec = WAIT_FOREVER) {
 				if (!_response || !sent) {
 					return false;
 				}
-				std::future<bool> future = _response->GetFuture();
-				if (timeoutMsec == WAIT_FOREVER) {
-					future.wait();
-				} else {
-					if (future.wait_for(timeoutMsec) == std::future_status::timeout) {
-						return false;
-					}
+				std::optional<TaskPool::BlockingScope> blocking;
+				if (auto *executor = CurrentExecutor()) blocking.emplace(*executor);
+				if (!_response->Wait(timeoutMsec)) {
+					return false;
 				}
-				return future.get();
+				return _response->GetResponse();
+			}
+
+			template <typename V>
+			RpcResult<V> WaitForResult(std::chrono::milliseconds timeoutMsec = WAIT_FOREVER) {
+				if (!_response || !sent) {
+					return { Error::Code::InvalidOperation };
+				}
+				std::optional<TaskPool::BlockingScope> blocking;
+				if (auto *executor = CurrentExecutor()) blocking.emplace(*executor);
+				if (!_response->Wait(timeoutMsec)) {
+					return { Error::Code::Timeout };
+				}
+				auto [handled, result] = static_cast<Sync::TypedCompletion<V> *>(_response)->GetResult();
+				return RpcResult<V>::FromResponse(handled, std::move(result));
 			}
 		private:
 		};
 
 		EventAggregator *const _eventAggregator{ nullptr };
 		std::shared_ptr<MessageQueue> _messageQueue;
+		Message::BoundedDeque<MessageContent> *_boundedMailbox{ nullptr };
+		const bool _priorityLanes{ false };
+		TaskPool *const _executor{ nullptr };
+		std::atomic<uint32_t> _exited{ 0 };
+		// closed is set once the consumer has stopped for good; whoever sends after that fails what
+		// is left. Shared with continuation posters, which may outlive the task.
+		struct _Closing {
+			std::atomic<bool> closed{ false };
+			std::mutex reclaimMutex{};
+			std::atomic<std::size_t> abandoned{ 0 };
+		};
+		const std::shared_ptr<_Closing> _closing{ std::make_shared<_Closing>() };
 
+		ContinuationPoster _continuationPoster;
 		std::function<void()> _onStart;
 		std::function<void()> _onFinish;
+		std::function<void(std::exception_ptr)> _onError;
+		ErrorSink _errorSink;
+		std::atomic<uint64_t> _asyncErrors{ 0 };
+		std::atomic<std::size_t> _receiveBatchSize{ 1 };
 		bool stop = false;
+		std::atomic<bool> _discarding{ false };
+
+		std::atomic<bool> _metricsEnabled{ false };
+		std::atomic<uint64_t> _processedEvents{ 0 };
+		std::atomic<std::size_t> _highWaterMark{ 0 };
+		Metrics::Histogram<> _queueWait{};
+		// Written by the mainloop only; the mutex guards insertions against concurrent snapshots.
+		std::map<Command, std::unique_ptr<Metrics::Histogram<>>> _dispatchTime{};
+		mutable std::mutex _metricsMutex{};
+
+		// A coalesced command has at most one event in the mailbox: a COALESCED marker whose request
+		// waits here, so later sends can still update it until the marker is dispatched.
+		// The merge callback and the marker send run outside _coalesceMutex; while a sender merges,
+		// pending is checked out and other senders of the command wait for it.
+		struct _CoalesceSlot {
+			std::function<void(_EventRequest &, _EventRequest &&)> merge{};
+			std::optional<_EventRequest> pending{};
+			bool queued{ false };
+			bool merging{ false };
+		};
+		std::atomic<bool> _coalescing{ false };
+		std::atomic<uint64_t> _coalescedEvents{ 0 };
+		std::map<Command, _CoalesceSlot> _coalesceSlots{};
+		std::mutex _coalesceMutex{};
+		std::condition_variable _coalesceCondition{};
 	public:
+		using QueueType = Message::MessageQueueFactory::Type;
+		using OverflowPolicy = Message::OverflowPolicy;
+
+		// capacity sizes RING_BUFFER and BOUNDED_DEQUE mailboxes; overflow applies to BOUNDED_DEQUE
+		// and only to external events, so Start, Stop and continuations are never refused or dropped.
+		// priorityLanes enables HIGH and LOW events, at the cost of checking the lanes on every receive.
+		struct Mailbox {
+			QueueType type{ QueueType::SYNCHRONIZED_DEQUE };
+			std::size_t capacity{ Message::RingBuffer<MessageContent>::DEFAULT_CAPACITY };
+			OverflowPolicy overflow{ OverflowPolicy::BLOCK };
+			bool priorityLanes{ false };
+		};
+
+		// Histograms are in nanoseconds. Queue wait covers only events sent while metrics were enabled.
+		struct MailboxMetrics {
+			uint64_t processedEvents{ 0 };
+			uint64_t coalescedEvents{ 0 };
+			std::size_t discardedEvents{ 0 };
+			// Dropped because the task stopped before handling them.
+			std::size_t abandonedEvents{ 0 };
+			std::size_t highWaterMark{ 0 };
+			std::size_t currentDepth{ 0 };
+			Metrics::HistogramSnapshot queueWait{};
+			std::vector<std::pair<Command, Metrics::HistogramSnapshot>> dispatchTime{};
+		};
+
+		using TaskBase::GetId;
+		using IEventTask<T, R>::SendEvent;
+		using IEventTask<T, R>::RpcEvent;
+
 		EventTaskBase(TaskType type, const std::string &name,
-			EventAggregator *eventAggregator) :
+			EventAggregator *eventAggregator, QueueType queueType = QueueType::SYNCHRONIZED_DEQUE) :
+			EventTaskBase(type, name, eventAggregator, Mailbox{ queueType }) {}
+
+		// With an executor the task gets no thread of its own: its events are dispatched by the
+		// executor's workers, still one at a time and in order. The executor must outlive the task.
+		// A handler that makes a blocking RPC holds its worker until the reply arrives; only an elastic
+		// executor (maxConcurrency above concurrency) adds a worker meanwhile, so on a fixed executor
+		// blocking RPCs between its tasks deadlock once every worker waits.
+		EventTaskBase(TaskType type, const std::string &name,
+			EventAggregator *eventAggregator, const Mailbox &mailbox, TaskPool *executor = nullptr) :
 			TaskBase(type, name), _eventAggregator(eventAggregator),
-			_messageQueue(Message::MessageQueueFactory::Create<MessageContent>()) {
+			_messageQueue(_CreateMailbox(mailbox)), _priorityLanes(mailbox.priorityLanes), _executor(executor) {
+			_boundedMailbox = dynamic_cast<Message::BoundedDeque<MessageContent> *>(_messageQueue.get());
+			if (mailbox.priorityLanes) {
+				_messageQueue = std::make_shared<_LanedMailbox>(std::move(_messageQueue));
+			}
+			if (_executor) {
+				_messageQueue = std::make_shared<_ActorMailbox>(std::move(_messageQueue), [this] {
+					_executor->Enqueue([this] { _Drain(); });
+				});
+			}
+			_continuationPoster = [messageQueue = std::weak_ptr(_messageQueue), closing = _closing](Response *response) {
+				auto queue = messageQueue.lock();
+				if (!queue) {
+					return false;
+				}
+				// The continuation may resume and free this poster as soon as it is sent.
+				auto state = closing;
+				queue->Send({ Attribute::CONTINUATION, _EventRequest{}, response });
+				_ReclaimIfClosed(*state, *queue);
+				return true;
+			};
+
+			_errorSink = [this](std::exception_ptr exception) {
+				_asyncErrors.fetch_add(1, std::memory_order_relaxed);
+				if (_onError) _onError(exception);
+			};
 
-			_thread = std::thread([this]() {
-				_Mainloop();
-			});
+			if (!_executor) {
+				_thread = std::thread([this]() {
+					_Mainloop();
+				});
+			}
 		}
 
 		~EventTaskBase() {
 			Stop();
+			_Reclaim();
 		}
 
 		void Start() override {
-			Sender sender{ _messageQueue, true };
+			Sender sender{ _messageQueue, _AcquireResponse() };
 			sender.Send(Attribute::INTERNAL, _EventRequest{
-				"", static_cast<T>(InternalCommands::START) });
+				{}, static_cast<T>(InternalCommands::START) }, TaskPriority::HIGH);
+			_ReclaimIfClosed();
 			sender.WaitForResponse();
 		}
 
+		// Events queued before Stop are still handled; whatever arrives after STOP is dropped,
+		// with pending RPCs failing and continuations still run.
 		void Stop() override {
-			if (!IsRunning()) {
-				return;
-			}
-			Sender sender{ _messageQueue, true };
-			sender.Send(Attribute::INTERNAL, _EventRequest{
-				"", static_cast<T>(InternalCommands::STOP) });
-			sender.WaitForResponse();
-			_thread.join();
+			_Stop(TaskPriority::NORMAL);
+		}
+
+		// Stops without handling the events still queued, dropping them the way Stop drops late ones.
+		// STOP takes the HIGH lane when there is one. Returns how many events were dropped.
+		std::size_t StopNow() {
+			const std::size_t abandoned = _closing->abandoned.load();
+			_discarding.store(true);
+			_Stop(TaskPriority::HIGH);
+			return _closing->abandoned.load() - abandoned;
 		}
 
 		void SendEvent(_EventRequest &&request) override {
-			Sender sender(_messageQueue, false);
+			if (_IsCoalescing() && _Coalesce(request)) {
+				return;
+			}
+			Sender sender(_messageQueue, nullptr, _IsMetricsEnabled());
 			sender.Send(Attribute::EXTERNAL, std::move(request));
 		}
 
-		void SendEvent(const _EventRequest &request) override {
-			Sender sender(_messageQueue, false);
-			sender.Send(Attribute::EXTERNAL, request);
+		// HIGH events are handled before anything already queued, LOW ones only when the mailbox is
+		// otherwise empty. Lane events bypass coalescing and the mailbox capacity. Other than NORMAL
+		// needs a mailbox with priorityLanes.
+		void SendEvent(_EventRequest &&request, TaskPriority priority) {
+			if (priority == TaskPriority::NORMAL) {
+				SendEvent(std::move(request));
+				return;
+			}
+			if (!_priorityLanes) {
+				throw Exception("Mailbox has no priority lanes", Error::Code::InvalidOperation);
+			}
+			Sender sender(_messageQueue, nullptr, _IsMetricsEnabled());
+			sender.Send(Attribute::EXTERNAL, std::move(request), priority);
+		}
+
+		void SendEvent(const _EventRequest &request, TaskPriority priority) {
+			static_assert(_IS_COPYABLE, "move-only requests must be passed as rvalues");
+			SendEvent(_EventRequest(request), priority);
+		}
+
+		// Like SendEvent, but reports a full FAIL mailbox as Overflow instead of throwing.
+		Error::Code TrySendEvent(_EventRequest &&request) {
+			if (_IsCoalescing() && _Coalesce(request)) {
+				return Error::Code::Success;
+			}
+			Sender sender(_messageQueue, nullptr, _IsMetricsEnabled());
+			return sender.TrySend(Attribute::EXTERNAL, std::move(request)) ? Error::Code::Success : Error::Code::Overflow;
+		}
+
+		Error::Code TrySendEvent(const _EventRequest &request) {
+			static_assert(_IS_COPYABLE, "move-only requests must be passed as rvalues");
+			return TrySendEvent(_EventRequest(request));
 		}
 
 		bool RpcEvent(_EventRequest &&request, std::chrono::milliseconds timeoutMsec = WAIT_FOREVER) override {
-			Sender sender(_messageQueue, true);
+			Sender sender(_messageQueue, _AcquireResponse(), _IsMetricsEnabled());
 			sender.Send(Attribute::EXTERNAL, std::move(request));
+			_ReclaimIfClosed();
 			return sender.WaitForResponse(timeoutMsec);
 		}
 
-		bool RpcEvent(const _EventRequest &request, std::chrono::milliseconds timeoutMsec = WAIT_FOREVER) override {
-			Sender sender(_messageQueue, true);
+		// Waits for a value the handler hands back through MessageEventArgs::SetResult.
+		template <typename V>
+		RpcResult<V> RpcEvent(_EventRequest &&request, std::chrono::milliseconds timeoutMsec = WAIT_FOREVER) {
+			Sender sender(_messageQueue, _AcquireResponse<V>(), _IsMetricsEnabled());
+			sender.Send(Attribute::EXTERNAL, std::move(request));
+			_ReclaimIfClosed();
+			return sender.template WaitForResult<V>(timeoutMsec);
+		}
+
+		template <typename V>
+		RpcResult<V> RpcEvent(const _EventRequest &request, std::chrono::milliseconds timeoutMsec = WAIT_FOREVER) {
+			static_assert(_IS_COPYABLE, "move-only requests must be passed as rvalues");
+			Sender sender(_messageQueue, _AcquireResponse<V>(), _IsMetricsEnabled());
 			sender.Send(Attribute::EXTERNAL, request);
-			return sender.WaitForResponse(timeoutMsec);
+			_ReclaimIfClosed();
+			return sender.template WaitForResult<V>(timeoutMsec);
+		}
+
+		// Issues the request without blocking; callback receives the outcome. Called from an event task,
+		// the callback runs on that task's thread between its other events, otherwise on this task's thread.
+		template <typename V>
+		void RpcEventAsync(_EventRequest &&request, std::function<void(RpcResult<V>)> callback) {
+			auto *response = new AsyncCompletion<V>(std::move(callback));
+			try {
+				MessageContent content{ Attribute::EXTERNAL, std::move(request), response };
+				if (_IsMetricsEnabled()) content.Stamp();
+				_messageQueue->Send(std::move(content));
+			} catch (...) {
+				delete response;
+				throw;
+			}
+			_ReclaimIfClosed();
+		}
+
+		template <typename V>
+		class RpcAwaiter {
+			EventTaskBase *_task;
+			_EventRequest _request;
+			std::optional<RpcResult<V>> _result{};
+		public:
+			RpcAwaiter(EventTaskBase *task, _EventRequest &&request) :
+				_task(task), _request(std::move(request)) {}
+
+			bool await_ready() const noexcept { return false; }
+
+			void await_suspend(std::coroutine_handle<> handle) {
+				_task->template RpcEventAsync<V>(std::move(_request), [this, handle](RpcResult<V> result) {
+					_result.emplace(std::move(result));
+					handle.resume();
+				});
+			}
+
+			RpcResult<V> await_resume() { return std::move(*_result); }
+		};
+
+		// co_await form of RpcEventAsync; the request is sent when the coroutine suspends.
+		template <typename V>
+		RpcAwaiter<V> RpcEventAsync(_EventRequest &&request) {
+			return { this, std::move(request) };
 		}
 
 		void SetOnStart(const std::function<void()> &onStart) {
@@ -188,30 +703,240 @@ namespace Framework::Task {
 			_onFinish = onFinish;
 		}
 
+		// Called on the task's thread with exceptions that escape its coroutine handlers and the
+		// RpcEventAsync callbacks it runs.
+		void SetOnError(const std::function<void(std::exception_ptr)> &onError) {
+			_onError = onError;
+		}
+
+		uint64_t CountAsyncErrors() const {
+			return _asyncErrors.load(std::memory_order_relaxed);
+		}
+
 		bool IsRunning() const noexcept {
-			return _thread.joinable();
+			return _executor ? _exited.load(std::memory_order_acquire) == 0 : _thread.joinable();
+		}
+
+		// Drains up to batchSize messages per wake-up; 1 receives one message at a time.
+		void SetReceiveBatchSize(std::size_t batchSize) {
+			_receiveBatchSize = batchSize == 0 ? 1 : batchSize;
+		}
+
+		// Events sent to command with SendEvent while an earlier one is still queued are folded into it
+		// by merge(pending, request); by default the newer request replaces the pending one.
+		// The event keeps the queue position of the first send. RpcEvent is never coalesced.
+		void SetCoalescing(Command command,
+			std::function<void(_EventRequest &, _EventRequest &&)> merge = {}) {
+			std::lock_guard<std::mutex> lock(_coalesceMutex);
+			_coalesceSlots[command].merge = std::move(merge);
+			_coalescing.store(true, std::memory_order_release);
+		}
+
+		// Instruments external events: queue wait, per-command dispatch time and mailbox depth.
+		void EnableMetrics(bool enable = true) {
+			_metricsEnabled.store(enable, std::memory_order_relaxed);
+		}
+
+		MailboxMetrics GetMailboxMetrics() const {
+			MailboxMetrics metrics;
+			metrics.processedEvents = _processedEvents.load(std::memory_order_relaxed);
+			metrics.abandonedEvents = _closing->abandoned.load(std::memory_order_relaxed);
+			metrics.coalescedEvents = _coalescedEvents.load(std::memory_order_relaxed);
+			if (_boundedMailbox) {
+				metrics.discardedEvents = _boundedMailbox->CountDiscarded();
+			}
+			metrics.highWaterMark = _highWaterMark.load(std::memory_order_relaxed);
+			metrics.currentDepth = _messageQueue->NumMessages();
+			metrics.queueWait = _queueWait.Snapshot();
+			std::lock_guard<std::mutex> lock(_metricsMutex);
+			for (const auto &[command, histogram] : _dispatchTime) {
+				metrics.dispatchTime.emplace_back(command, histogram->Snapshot());
+			}
+			return metrics;
 		}
 	private:
+		void _Stop(TaskPriority priority) {
+			if (!IsRunning()) {
+				return;
+			}
+			Sender sender{ _messageQueue, _AcquireResponse() };
+			sender.Send(Attribute::INTERNAL, _EventRequest{
+				{}, static_cast<T>(InternalCommands::STOP) }, priority);
+			sender.WaitForResponse();
+			if (_executor) {
+				while (_exited.load(std::memory_order_acquire) == 0) {
+					Sync::Futex::Wait(_exited, 0);
+				}
+			} else {
+				_thread.join();
+			}
+		}
+
 		void _Mainloop() {
+			CurrentContinuationPoster() = &_continuationPoster;
+			CurrentErrorSink() = &_errorSink;
+			std::deque<MessageContent> batch;
 			while (!stop) {
-				MessageContent content = _messageQueue->Receive();
-				try {
-					bool responseValue = true;
-					if (content.GetAttribute().IsInternal()) {
-						_ProcessInternalCommand(content.GetRequest());
+				const std::size_t batchSize = _receiveBatchSize.load(std::memory_order_relaxed);
+				if (batchSize == 1) {
+					auto content = _messageQueue->Receive();
+					_SampleDepth(1);
+					_Dispatch(content);
+					continue;
+				}
+				_messageQueue->ReceiveBatch(batch, batchSize);
+				_SampleDepth(batch.size());
+				for (auto &content : batch) {
+					if (stop) {
+						_Abandon(*_closing, content);
 					} else {
-						responseValue = _ProcessEvent(content.GetRequest());
-					}
-					if (content.IsResponseRequired()) {
-						content.GetResponseBuffer()->Set(responseValue);
-					}
-				} catch (...) {
-					if (content.IsResponseRequired()) {
-						content.GetResponseBuffer()->HandleException();
+						_Dispatch(content);
 					}
 				}
+				batch.clear();
+			}
+			_Close();
+			CurrentContinuationPoster() = nullptr;
+			CurrentErrorSink() = nullptr;
+			if (_onFinish) _onFinish();
+		}
+
+		// One turn of the task on its executor. After ACTOR_BUDGET events the drain requeues itself
+		// behind the executor's other work instead of holding on to the worker.
+		void _Drain() {
+			const auto queue = _messageQueue;
+			auto &mailbox = static_cast<_ActorMailbox &>(*queue);
+			auto *poster = std::exchange(CurrentContinuationPoster(), &_continuationPoster);
+			auto *sink = std::exchange(CurrentErrorSink(), &_errorSink);
+			auto *executor = std::exchange(CurrentExecutor(), _executor);
+			bool released = false;
+			for (std::size_t dispatched = 0; !stop && dispatched < ACTOR_BUDGET;) {
+				auto [received, content] = mailbox.TryReceive();
+				if (received) {
+					_SampleDepth(1);
+					_Dispatch(content);
+					dispatched++;
+				} else if (mailbox.Release()) {
+					released = true;
+					break;
+				}
+			}
+			if (stop) {
+				_Close();
+			}
+			CurrentContinuationPoster() = poster;
+			CurrentErrorSink() = sink;
+			CurrentExecutor() = executor;
+			if (released) {
+				return;
+			}
+			if (!stop) {
+				_executor->Enqueue([this] { _Drain(); });
+				return;
 			}
 			if (_onFinish) _onFinish();
+			_exited.store(1, std::memory_order_release);
+			Sync::Futex::WakeAll(_exited);
+		}
+
+		void _Dispatch(const MessageContent &content) {
+			if (content.GetAttribute().IsContinuation()) {
+				try {
+					content.GetResponseBuffer()->Continue();
+				} catch (...) {
+					ReportAsyncError(std::current_exception());
+				}
+				return;
+			}
+			if (_discarding.load(std::memory_order_relaxed) && !content.GetAttribute().IsInternal()) {
+				_Abandon(*_closing, content);
+				return;
+			}
+			if (content.GetAttribute().IsCoalesced()) {
+				_DispatchCoalesced(content);
+				return;
+			}
+			try {
+				bool responseValue = true;
+				if (content.GetAttribute().IsInternal()) {
+					_ProcessInternalCommand(content.GetRequest());
+				} else if (_IsMetricsEnabled()) {
+					responseValue = _ProcessEventMeasured(content);
+				} else {
+					responseValue = _ProcessEvent(content.GetRequest(), content.GetResponseBuffer());
+				}
+				if (content.IsResponseRequired()) {
+					content.GetResponseBuffer()->Set(responseValue);
+				}
+			} catch (...) {
+				if (content.IsResponseRequired()) {
+					content.GetResponseBuffer()->HandleException();
+				}
+			}
+		}
+
+		// Drops whatever is still queued once the task has stopped. Continuations still run so blocked
+		// callers are released; RPCs fail instead of waiting forever.
+		static void _AbandonPending(_Closing &closing, MessageQueue &queue) {
+			while (true) {
+				auto [received, content] = queue.TryReceive();
+				if (!received) {
+					break;
+				}
+				_Abandon(closing, content);
+			}
+		}
+
+		// Pairs with _ReclaimIfClosed: a message sent after the consumer's last look at the queue is
+		// seen either here or by its sender, so no response is left pending.
+		void _Close() {
+			_closing->closed.store(true, std::memory_order_seq_cst);
+			_Reclaim();
+		}
+
+		void _ReclaimIfClosed() {
+			_ReclaimIfClosed(*_closing, *_messageQueue);
+		}
+
+		void _Reclaim() {
+			_Reclaim(*_closing, *_messageQueue);
+		}
+
+		static void _ReclaimIfClosed(_Closing &closing, MessageQueue &queue) {
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (closing.closed.load(std::memory_order_relaxed)) {
+				_Reclaim(closing, queue);
+			}
+		}
+
+		static void _Reclaim(_Closing &closing, MessageQueue &queue) {
+			std::lock_guard<std::mutex> lock(closing.reclaimMutex);
+			_AbandonPending(closing, queue);
+		}
+
+		static void _Abandon(_Closing &closing, const MessageContent &content) {
+			if (content.GetAttribute().IsContinuation()) {
+				try {
+					content.GetResponseBuffer()->Continue();
+				} catch (...) {
+					ReportAsyncError(std::current_exception());
+				}
+				return;
+			}
+			if (!content.GetAttribute().IsInternal()) {
+				closing.abandoned.fetch_add(1, std::memory_order_relaxed);
+			}
+			if (content.IsResponseRequired()) {
+				_Fail(content, "Task stopped", Error::Code::InvalidOperation);
+			}
+		}
+
+		static void _Fail(const MessageContent &content, const char *message, Error::Code code) {
+			try {
+				throw Exception(message, code);
+			} catch (...) {
+				content.GetResponseBuffer()->HandleException();
+			}
 		}
 
 		void _ProcessInternalCommand(const _EventRequest &request) {
@@ -229,11 +954,172 @@ namespace Framework::Task {
 			}
 		}
 
-		bool _ProcessEvent(const _EventRequest &request) {
+		bool _ProcessEvent(const _EventRequest &request, Response *response) {
 			if (__Likely(_eventAggregator)) {
-				return _eventAggregator->Publish(request.GetCommand(), MessageEventArgs(&request));
+				return _eventAggregator->Publish(request.GetCommand(), MessageEventArgs<T, R>(&request, response));
 			}
 			return false;
 		}
+
+		bool _IsCoalescing() const {
+			return _coalescing.load(std::memory_order_acquire);
+		}
+
+		// True when request was taken over, either folded into a pending event or queued as a new one.
+		bool _Coalesce(_EventRequest &request) {
+			const Command command = request.GetCommand();
+			std::unique_lock<std::mutex> lock(_coalesceMutex);
+			auto found = _coalesceSlots.find(command);
+			if (found == _coalesceSlots.end()) {
+				return false;
+			}
+			_CoalesceSlot &slot = found->second;
+			_coalesceCondition.wait(lock, [&slot] { return !slot.merging; });
+			if (!slot.pending) {
+				slot.pending.emplace(std::move(request));
+				_QueueCoalesced(slot, command, lock);
+				return true;
+			}
+			_coalescedEvents.fetch_add(1, std::memory_order_relaxed);
+			if (!slot.merge) {
+				*slot.pending = std::move(request);
+				_QueueCoalesced(slot, command, lock);
+				return true;
+			}
+			auto merge = slot.merge;
+			auto pending = std::move(*slot.pending);
+			slot.pending.reset();
+			slot.merging = true;
+			lock.unlock();
+			std::exception_ptr failure;
+			try {
+				merge(pending, std::move(request));
+			} catch (...) {
+				failure = std::current_exception();
+			}
+			lock.lock();
+			slot.pending.emplace(std::move(pending));
+			slot.merging = false;
+			_coalesceCondition.notify_all();
+			_QueueCoalesced(slot, command, lock);
+			if (failure) {
+				std::rethrow_exception(failure);
+			}
+			return true;
+		}
+
+		// Sends the marker for slot, after unlocking, unless one is already in the mailbox. If the send
+		// fails the request stays pending and the next send of the command retries the marker.
+		void _QueueCoalesced(_CoalesceSlot &slot, Command command, std::unique_lock<std::mutex> &lock) {
+			if (slot.queued) {
+				return;
+			}
+			slot.queued = true;
+			lock.unlock();
+			try {
+				Sender sender(_messageQueue, nullptr, _IsMetricsEnabled());
+				sender.Send(Attribute::COALESCED, _EventRequest{ {}, command });
+			} catch (...) {
+				lock.lock();
+				slot.queued = false;
+				throw;
+			}
+		}
+
+		// A marker dispatched while its request is checked out for merging finds nothing; the merging
+		// sender then queues a new marker.
+		void _DispatchCoalesced(const MessageContent &marker) {
+			std::optional<_EventRequest> request;
+			{
+				std::lock_guard<std::mutex> lock(_coalesceMutex);
+				auto slot = _coalesceSlots.find(marker.GetRequest().GetCommand());
+				if (slot != _coalesceSlots.end()) {
+					request.swap(slot->second.pending);
+					slot->second.queued = false;
+				}
+			}
+			if (request) {
+				MessageContent content{ Attribute::EXTERNAL, std::move(*request) };
+				content.Stamp(marker.GetEnqueued());
+				_Dispatch(content);
+			}
+		}
+
+		static MessageQueue *_CreateMailbox(const Mailbox &mailbox) {
+			if (mailbox.type == QueueType::RING_BUFFER && mailbox.overflow != OverflowPolicy::BLOCK) {
+				throw Exception("Ring buffer mailboxes only block on overflow", Error::Code::InvalidArgument);
+			}
+			if (mailbox.type != QueueType::BOUNDED_DEQUE) {
+				return Message::MessageQueueFactory::Create<MessageContent>(mailbox.type, mailbox.capacity);
+			}
+			typename Message::BoundedDeque<MessageContent>::Handlers handlers;
+			handlers.exempt = [](const MessageContent &content) {
+				return !content.GetAttribute().IsExternal();
+			};
+			handlers.coalesce = [](const MessageContent &queued, const MessageContent &content) {
+				return queued.GetRequest().GetCommand() == content.GetRequest().GetCommand();
+			};
+			handlers.discard = [](MessageContent &&content) {
+				if (content.IsResponseRequired()) {
+					_Fail(content, "Event discarded from a full mailbox", Error::Code::Overflow);
+				}
+			};
+			return new Message::BoundedDeque<MessageContent>(mailbox.capacity, mailbox.overflow, std::move(handlers));
+		}
+
+		bool _IsMetricsEnabled() const {
+			return _metricsEnabled.load(std::memory_order_relaxed);
+		}
+
+		// received counts the messages already taken off the queue but not yet dispatched.
+		void _SampleDepth(std::size_t received) {
+			if (!_IsMetricsEnabled()) {
+				return;
+			}
+			const std::size_t depth = _messageQueue->NumMessages() + received;
+			std::size_t current = _highWaterMark.load(std::memory_order_relaxed);
+			while (depth > current && !_highWaterMark.compare_exchange_weak(current, depth, std::memory_order_relaxed)) {}
+		}
+
+		bool _ProcessEventMeasured(const MessageContent &content) {
+			using Clock = std::chrono::steady_clock;
+			const auto start = Clock::now();
+			if (content.GetEnqueued() != Clock::time_point{}) {
+				_queueWait.Record(_Nanoseconds(start - content.GetEnqueued()));
+			}
+			struct Finish {
+				EventTaskBase *task;
+				Command command;
+				Clock::time_point start;
+				~Finish() {
+					task->_DispatchHistogram(command).Record(_Nanoseconds(Clock::now() - start));
+					task->_processedEvents.fetch_add(1, std::memory_order_relaxed);
+				}
+			} finish{ this, content.GetRequest().GetCommand(), start };
+			return _ProcessEvent(content.GetRequest(), content.GetResponseBuffer());
+		}
+
+		Metrics::Histogram<> &_DispatchHistogram(Command command) {
+			auto found = _dispatchTime.find(command);
+			if (found != _dispatchTime.end()) {
+				return *found->second;
+			}
+			std::lock_guard<std::mutex> lock(_metricsMutex);
+			return *_dispatchTime.emplace(command, std::make_unique<Metrics::Histogram<>>()).first->second;
+		}
+
+		static uint64_t _Nanoseconds(std::chrono::steady_clock::duration duration) {
+			return static_cast<uint64_t>(std::max<int64_t>(
+				std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count(), 0));
+		}
+
+		template <typename V = void>
+		static Response *_AcquireResponse() {
+			if constexpr (std::is_void_v<V>) {
+				return Sync::CompletionPool<Response>::AcquireLocal();
+			} else {
+				return Sync::CompletionPool<Sync::TypedCompletion<V>>::AcquireLocal();
+			}
+		}
 	};
 } // namespace Framework::Task
@@ -2,9 +2,15 @@
 
 #include <functional>
 #include <map>
+#include <vector>
 #include <initializer_list>
 #include <type_traits>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <atomic>
 
+#include "utility.hpp"
 #include "Exception/Exception.hpp"
 
 #include "Task/EventRequest.hpp"
@@ -15,11 +21,11 @@ namespace Framework::Task {
 	using namespace Framework;
 
 	template <typename T = EventRequest<>::Command,
-		typename U = int64_t>
+		typename U = int64_t, typename R = EventRequest<T>>
 	class MessageEventAggregator :
-		public EventTaskBase<T>::EventAggregator {
+		public EventTaskBase<T, R>::EventAggregator {
 	public:
-		using EventHandler = std::function<bool(const MessageEventArgs<T> &)>;
+		using EventHandler = std::function<bool(const MessageEventArgs<T, R> &)>;
 		using Command = T;
 		using State = U;
 		static constexpr State KEEP_STATE = static_cast<State>(-1);
@@ -41,8 +47,7 @@ namespace Framework::Task {
 				}
 			}
 
-			template <typename _U>
-			bool Handle(const MessageEventArgs<_U> &args) {
+			bool Handle(const MessageEventArgs<T, R> &args) const {
 				return _handler(args);
 			}
 
@@ -51,27 +56,146 @@ namespace Framework::Task {
 
 		using MessageEvent = std::pair<const Command, MessageInfo<State>>;
 		using EventMap = std::map<Command, MessageInfo<State>>;
+
+		enum class UnhandledPolicy : uint8_t {
+			RETURN_FALSE = 0,
+			THROW,
+		};
 	private:
-		EventMap _events;
+		class _Counter {
+			std::atomic<uint64_t> _value{ 0 };
+		public:
+			_Counter() = default;
+			_Counter(const _Counter &other) : _value(other.Get()) {}
+			_Counter &operator=(const _Counter &other) {
+				_value.store(other.Get(), std::memory_order_relaxed);
+				return *this;
+			}
+			void Increment() { _value.fetch_add(1, std::memory_order_relaxed); }
+			uint64_t Get() const { return _value.load(std::memory_order_relaxed); }
+		};
+
+		using _Key = uint64_t;
+		using _Index = uint32_t;
+		static constexpr _Index _NOT_FOUND = std::numeric_limits<_Index>::max();
+		// Command ranges up to this many times the number of commands use a flat table.
+		static constexpr _Key _DENSE_FACTOR = 4;
+		static constexpr _Key _MIN_DENSE_RANGE = 64;
+
+		std::vector<MessageInfo<State>> _infos;
+		std::vector<_Key> _keys;
+		std::vector<_Index> _table;
+		_Key _minKey{ 0 };
+
+		EventHandler _fallbackHandler;
+		UnhandledPolicy _unhandledPolicy{ UnhandledPolicy::RETURN_FALSE };
+		_Counter _unhandledEvents;
+
+		static constexpr _Key _ToKey(Command command) {
+			using Underlying = typename std::conditional_t<std::is_enum_v<Command>,
+				std::underlying_type<Command>, std::type_identity<Command>>::type;
+			const auto value = static_cast<Underlying>(command);
+			if constexpr (std::is_signed_v<Underlying>) {
+				return static_cast<_Key>(static_cast<int64_t>(value)) ^ (_Key{ 1 } << 63);
+			} else {
+				return static_cast<_Key>(value);
+			}
+		}
+
+		void _Build(const EventMap &events) {
+			_infos.reserve(events.size());
+			_keys.reserve(events.size());
+			for (const auto &[command, info] : events) {
+				_keys.push_back(_ToKey(command));
+				_infos.push_back(info);
+			}
+			if (_keys.empty()) {
+				return;
+			}
+			_minKey = _keys.front();
+			const _Key range = _keys.back() - _minKey;
+			if (range >= std::max(_MIN_DENSE_RANGE, _DENSE_FACTOR * _keys.size())) {
+				return;
+			}
+			_table.assign(range + 1, _NOT_FOUND);
+			for (_Index i = 0; i < _keys.size(); i++) {
+				_table[_keys[i] - _minKey] = i;
+			}
+			_keys.clear();
+			_keys.shrink_to_fit();
+		}
+
+		_Index _Lookup(_Key key) const {
+			if (!_table.empty()) {
+				const _Key offset = key - _minKey;
+				return offset < _table.size() ? _table[offset] : _NOT_FOUND;
+			}
+			const _Key *base = _keys.data();
+			std::size_t length = _keys.size();
+			if (length == 0) {
+				return _NOT_FOUND;
+			}
+			while (length > 1) {
+				const std::size_t half = length / 2;
+				base = (base[half] <= key) ? base + half : base;
+				length -= half;
+			}
+			return *base == key ? static_cast<_Index>(base - _keys.data()) : _NOT_FOUND;
+		}
 
 	public:
-		MessageEventAggregator(const EventMap &events) : _events(events) {}
+		MessageEventAggregator(const EventMap &events) {
+			_Build(events);
+		}
+
+		// Returns nullptr when no handler is registered for the command.
+		const MessageInfo<State> *Find(Command command) const {
+			const _Index index = _Lookup(_ToKey(command));
+			return index == _NOT_FOUND ? nullptr : &_infos[index];
+		}
+
+		bool Publish(Command command, const MessageEventArgs<T, R> &args) override {
+			const auto *info = Find(command);
+			if (__Likely(info)) {
+				return info->Handle(args);
+			}
+			return PublishUnhandled(args);
+		}
 
-		bool Publish(Command command, const MessageEventArgs<T> &args) override {
-			try {
-				auto &info = _events.at(command);
-				return info.Handle(args);
-			} catch (const std::out_of_range &e) {
+		// Miss path: counts the event, then throws, calls the fallback handler or returns false.
+		bool PublishUnhandled(const MessageEventArgs<T, R> &args) {
+			_unhandledEvents.Increment();
+			if (_unhandledPolicy == UnhandledPolicy::THROW) {
 				throw Exception("Event not found", Error::Code::OutOfRange);
 			}
+			if (_fallbackHandler) {
+				return _fallbackHandler(args);
+			}
+			return false;
 		}
 
 		State GetNextState(Command command) const {
-			try {
-				return _events.at(command).GetNextState();
-			} catch (const std::out_of_range &e) {
+			const auto *info = Find(command);
+			if (__Likely(info)) {
+				return info->GetNextState();
+			}
+			if (_unhandledPolicy == UnhandledPolicy::THROW) {
 				throw Exception("Event not found", Error::Code::OutOfRange);
 			}
+			return KEEP_STATE;
+		}
+
+		// Must be configured before the owning task starts dispatching.
+		void SetFallbackHandler(const EventHandler &handler) {
+			_fallbackHandler = handler;
+		}
+
+		void SetUnhandledPolicy(UnhandledPolicy policy) {
+			_unhandledPolicy = policy;
+		}
+
+		uint64_t CountUnhandledEvents() const {
+			return _unhandledEvents.Get();
 		}
 	};
 } // namespace Framework::Task
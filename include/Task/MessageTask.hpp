@@ -10,12 +10,14 @@
 namespace Framework::Task {
 
 	template <typename _CommandType = MessageEventAggregator<>::Command,
+		typename _RequestType = EventRequest<_CommandType>,
 		std::enable_if_t<std::is_integral_v<_CommandType> || std::is_enum_v<_CommandType>,
 		nullptr_t> = nullptr>
-	class MessageTask : public EventTaskBase<_CommandType> {
-		using _Base = EventTaskBase<_CommandType>;
+	class MessageTask : public EventTaskBase<_CommandType, _RequestType> {
+		using _Base = EventTaskBase<_CommandType, _RequestType>;
 	public:
-		using EventAggregator = MessageEventAggregator<_CommandType>;
+		using EventAggregator = MessageEventAggregator<_CommandType,
+			MessageEventAggregator<>::State, _RequestType>;
 		using EventMap = EventAggregator::EventMap;
 	private:
 		EventAggregator _eventAggregator;
@@ -33,7 +35,20 @@ namespace Framework::Task {
 		// MessageTask(const std::string &name, const EventAggregator::EventMap &events) :
 		// 	_Base(TaskType::MESSAGE, name, &_eventAggregator), _eventAggregator(events) {}
 
-		MessageTask(const std::string &name, const EventMap &events) :
-			_Base(TaskType::MESSAGE, name, &_eventAggregator), _eventAggregator(events) {}
+		MessageTask(const std::string &name, const EventMap &events,
+			typename _Base::QueueType queueType = _Base::QueueType::SYNCHRONIZED_DEQUE) :
+			_Base(TaskType::MESSAGE, name, &_eventAggregator, queueType), _eventAggregator(events) {}
+
+		MessageTask(const std::string &name, const EventMap &events, const typename _Base::Mailbox &mailbox) :
+			_Base(TaskType::MESSAGE, name, &_eventAggregator, mailbox), _eventAggregator(events) {}
+
+		// Runs the task's events on executor's workers instead of a dedicated thread.
+		MessageTask(const std::string &name, const EventMap &events, TaskPool &executor,
+			const typename _Base::Mailbox &mailbox = {}) :
+			_Base(TaskType::MESSAGE, name, &_eventAggregator, mailbox, &executor), _eventAggregator(events) {}
+
+		EventAggregator &GetEventAggregator() {
+			return _eventAggregator;
+		}
 	};
 } // namespace Framework::Task
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Task/TaskPool.hpp"
+
+namespace Framework::Task {
+	// Splits work into chunks claimed dynamically by pool workers and by the calling thread.
+	// The caller always makes progress itself, so nesting inside a pool task cannot deadlock.
+	class ParallelChunks final {
+		static constexpr std::size_t CHUNKS_PER_WORKER = 4;
+
+		// Owned jointly by the caller and its helpers; a helper that starts after Run has returned
+		// still finds the chunk callable alive, although no chunk is left for it to claim.
+		class _State {
+			std::atomic<std::size_t> _next{ 0 };
+			const std::size_t _count;
+			const std::function<void(std::size_t)> _chunk;
+			std::latch _done;
+			std::once_flag _failed{};
+			std::exception_ptr _exception{};
+		public:
+			_State(std::size_t count, std::function<void(std::size_t)> chunk) :
+				_count(count), _chunk(std::move(chunk)), _done(static_cast<std::ptrdiff_t>(count)) {}
+
+			void Work() {
+				std::size_t index;
+				while ((index = _next.fetch_add(1, std::memory_order_relaxed)) < _count) {
+					try {
+						_chunk(index);
+					} catch (...) {
+						std::call_once(_failed, [this] { _exception = std::current_exception(); });
+						_Skip();
+					}
+					_done.count_down();
+				}
+			}
+
+			void Join() {
+				_done.wait();
+				if (_exception) {
+					std::rethrow_exception(_exception);
+				}
+			}
+		private:
+			// Claims every remaining chunk so the latch still reaches zero after a failure.
+			void _Skip() {
+				std::size_t index;
+				while ((index = _next.fetch_add(1, std::memory_order_relaxed)) < _count) {
+					_done.count_down();
+				}
+			}
+		};
+	public:
+		// Chunk size for count elements; a non-zero grain is taken as is.
+		static std::size_t GrainSize(const TaskPool &pool, std::size_t count, std::size_t grain) {
+			if (grain != 0) {
+				return grain;
+			}
+			std::size_t chunks = std::max<std::size_t>(pool.Concurrency(), 1) * CHUNKS_PER_WORKER;
+			return std::max<std::size_t>(count / chunks, 1);
+		}
+
+		// Runs chunk(i) for every i in [0, count) and returns when all have finished.
+		template <typename F>
+		static void Run(TaskPool &pool, std::size_t count, const F &chunk) {
+			if (count == 0) {
+				return;
+			}
+			if (count == 1 || pool.Concurrency() == 0) {
+				for (std::size_t i = 0; i < count; i++) {
+					chunk(i);
+				}
+				return;
+			}
+			auto state = std::make_shared<_State>(count, chunk);
+			std::size_t helpers = std::min(pool.Concurrency(), count - 1);
+			for (std::size_t i = 0; i < helpers; i++) {
+				pool.Enqueue([state] { state->Work(); });
+			}
+			state->Work();
+			state->Join();
+		}
+	};
+
+	template <typename Index, typename F>
+	void ParallelFor(TaskPool &pool, Index first, Index last, F &&body, std::size_t grain = 0) {
+		if (!(first < last)) {
+			return;
+		}
+		const auto count = static_cast<std::size_t>(last - first);
+		const std::size_t chunkSize = ParallelChunks::GrainSize(pool, count, grain);
+		const std::size_t chunks = (count + chunkSize - 1) / chunkSize;
+		ParallelChunks::Run(pool, chunks, [&](std::size_t chunk) {
+			const Index begin = first + static_cast<Index>(chunk * chunkSize);
+			const Index end = first + static_cast<Index>(std::min(count, (chunk + 1) * chunkSize));
+			for (Index i = begin; i < end; ++i) {
+				body(i);
+			}
+		});
+	}
+
+	// Reduces map(i) over [first, last). Chunk results are combined in index order,
+	// so reduce only needs to be associative.
+	template <typename Index, typename T, typename Map, typename Reduce>
+	T ParallelReduce(TaskPool &pool, Index first, Index last, T identity,
+		Map &&map, Reduce &&reduce, std::size_t grain = 0) {
+		if (!(first < last)) {
+			return identity;
+		}
+		const auto count = static_cast<std::size_t>(last - first);
+		const std::size_t chunkSize = ParallelChunks::GrainSize(pool, count, grain);
+		const std::size_t chunks = (count + chunkSize - 1) / chunkSize;
+		std::vector<T> partials(chunks, identity);
+		ParallelChunks::Run(pool, chunks, [&](std::size_t chunk) {
+			const Index begin = first + static_cast<Index>(chunk * chunkSize);
+			const Index end = first + static_cast<Index>(std::min(count, (chunk + 1) * chunkSize));
+			T partial = identity;
+			for (Index i = begin; i < end; ++i) {
+				partial = reduce(std::move(partial), map(i));
+			}
+			partials[chunk] = std::move(partial);
+		});
+		T result = std::move(identity);
+		for (auto &partial : partials) {
+			result = reduce(std::move(result), std::move(partial));
+		}
+		return result;
+	}
+
+	// Sorts runs in parallel, then merges neighbouring runs pairwise in parallel rounds.
+	template <typename Iterator, typename Compare = std::less<>>
+	void ParallelSort(TaskPool &pool, Iterator first, Iterator last, Compare compare = {}, std::size_t grain = 0) {
+		const auto count = static_cast<std::size_t>(std::distance(first, last));
+		if (count < 2) {
+			return;
+		}
+		const std::size_t runSize = std::max<std::size_t>(
+			ParallelChunks::GrainSize(pool, count, grain), 2048);
+		const std::size_t runs = (count + runSize - 1) / runSize;
+		auto boundary = [&](std::size_t run) {
+			return first + static_cast<std::ptrdiff_t>(std::min(count, run * runSize));
+		};
+		ParallelChunks::Run(pool, runs, [&](std::size_t run) {
+			std::sort(boundary(run), boundary(run + 1), compare);
+		});
+		for (std::size_t width = 1; width < runs; width *= 2) {
+			const std::size_t merges = (runs + 2 * width - 1) / (2 * width);
+			ParallelChunks::Run(pool, merges, [&](std::size_t merge) {
+				const std::size_t left = merge * 2 * width;
+				const std::size_t middle = std::min(left + width, runs);
+				const std::size_t right = std::min(left + 2 * width, runs);
+				std::inplace_merge(boundary(left), boundary(middle), boundary(right), compare);
+			});
+		}
+	}
+} // namespace Framework::Task
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "utility.hpp"
+#include "Exception/Exception.hpp"
+#include "Templates/TypeId.hpp"
+
+namespace Framework::Task {
+	using namespace Framework;
+
+	// Move-only replacement for std::any that keeps small, nothrow-movable values inline
+	// and identifies the stored type without RTTI.
+	template <std::size_t INLINE_SIZE = 56>
+	class Payload {
+		using TypeId = Templates::TypeId;
+
+		template <typename U>
+		static constexpr TypeId _TypeIdOf() { return Templates::TypeIdOf<U>(); }
+
+		struct _Operations {
+			TypeId typeId;
+			void (*destroy)(Payload &) noexcept;
+			void (*move)(Payload &from, Payload &to) noexcept;
+		};
+
+		template <typename U>
+		static constexpr bool _IsInline = sizeof(U) <= INLINE_SIZE &&
+			alignof(U) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<U>;
+
+		template <typename U>
+		struct _InlineOperations {
+			static void Destroy(Payload &self) noexcept {
+				self._Inline<U>()->~U();
+			}
+			static void Move(Payload &from, Payload &to) noexcept {
+				::new (static_cast<void *>(to._buffer)) U(std::move(*from._Inline<U>()));
+				Destroy(from);
+			}
+			static constexpr _Operations table{ _TypeIdOf<U>(), &Destroy, &Move };
+		};
+
+		template <typename U>
+		struct _HeapOperations {
+			static void Destroy(Payload &self) noexcept {
+				delete self._Heap<U>();
+			}
+			static void Move(Payload &from, Payload &to) noexcept {
+				::new (static_cast<void *>(to._buffer)) U *(from._Heap<U>());
+			}
+			static constexpr _Operations table{ _TypeIdOf<U>(), &Destroy, &Move };
+		};
+
+		alignas(std::max_align_t) std::byte _buffer[INLINE_SIZE < sizeof(void *) ? sizeof(void *) : INLINE_SIZE];
+		const _Operations *_operations{ nullptr };
+
+		template <typename U>
+		U *_Inline() { return std::launder(reinterpret_cast<U *>(_buffer)); }
+		template <typename U>
+		const U *_Inline() const { return std::launder(reinterpret_cast<const U *>(_buffer)); }
+		template <typename U>
+		U *_Heap() const { return *std::launder(reinterpret_cast<U *const *>(_buffer)); }
+
+		template <typename U>
+		const U *_Get() const {
+			if constexpr (_IsInline<U>) {
+				return _Inline<U>();
+			} else {
+				return _Heap<U>();
+			}
+		}
+
+		void _MoveFrom(Payload &other) noexcept {
+			if (other._operations) {
+				other._operations->move(other, *this);
+				_operations = other._operations;
+				other._operations = nullptr;
+			}
+		}
+
+	public:
+		static constexpr std::size_t InlineSize = INLINE_SIZE;
+
+		template <typename U>
+		static constexpr bool IsInline = _IsInline<std::decay_t<U>>;
+
+		Payload() noexcept = default;
+
+		template <typename U, typename V = std::decay_t<U>,
+			std::enable_if_t<!std::is_same_v<V, Payload>, std::nullptr_t> = nullptr>
+		Payload(U &&value) {
+			Emplace<V>(std::forward<U>(value));
+		}
+
+		Payload(Payload &&other) noexcept { _MoveFrom(other); }
+
+		Payload &operator=(Payload &&other) noexcept {
+			if (this != &other) {
+				Reset();
+				_MoveFrom(other);
+			}
+			return *this;
+		}
+
+		Payload(const Payload &) = delete;
+		Payload &operator=(const Payload &) = delete;
+
+		~Payload() { Reset(); }
+
+		template <typename U, typename... Args>
+		U &Emplace(Args &&...args) {
+			Reset();
+			if constexpr (_IsInline<U>) {
+				::new (static_cast<void *>(_buffer)) U(std::forward<Args>(args)...);
+				_operations = &_InlineOperations<U>::table;
+				return *_Inline<U>();
+			} else {
+				U *value = new U(std::forward<Args>(args)...);
+				::new (static_cast<void *>(_buffer)) U *(value);
+				_operations = &_HeapOperations<U>::table;
+				return *value;
+			}
+		}
+
+		void Reset() noexcept {
+			if (_operations) {
+				_operations->destroy(*this);
+				_operations = nullptr;
+			}
+		}
+
+		bool HasValue() const noexcept { return _operations != nullptr; }
+
+		template <typename U>
+		bool Holds() const noexcept {
+			return _operations && _operations->typeId == _TypeIdOf<std::decay_t<U>>();
+		}
+
+		template <typename U>
+		const U &As() const {
+			if (__Unlikely(!Holds<U>())) {
+				throw Exception("Payload type mismatch", Error::Code::TypeMismatch);
+			}
+			return *_Get<std::decay_t<U>>();
+		}
+
+		template <typename U>
+		U &As() {
+			return const_cast<U &>(std::as_const(*this).template As<U>());
+		}
+	};
+
+	// Immutable, reference-counted payload. Copies share one value, so a request fanned out to many
+	// tasks costs a reference count per copy instead of a deep copy.
+	class SharedPayload {
+		using TypeId = Templates::TypeId;
+
+		TypeId _typeId{ nullptr };
+		std::shared_ptr<const void> _value{};
+	public:
+		SharedPayload() noexcept = default;
+
+		template <typename U, typename V = std::decay_t<U>,
+			std::enable_if_t<!std::is_same_v<V, SharedPayload>, std::nullptr_t> = nullptr>
+		SharedPayload(U &&value) :
+			_typeId(Templates::TypeIdOf<V>()), _value(std::make_shared<const V>(std::forward<U>(value))) {}
+
+		bool HasValue() const noexcept { return _value != nullptr; }
+
+		template <typename U>
+		bool Holds() const noexcept {
+			return _value && _typeId == Templates::TypeIdOf<std::decay_t<U>>();
+		}
+
+		template <typename U>
+		const U &As() const {
+			if (__Unlikely(!Holds<U>())) {
+				throw Exception("Payload type mismatch", Error::Code::TypeMismatch);
+			}
+			return *static_cast<const std::decay_t<U> *>(_value.get());
+		}
+
+		long UseCount() const noexcept { return _value.use_count(); }
+	};
+} // namespace Framework::Task
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace Framework::Task {
+	enum class TaskPriority : uint8_t {
+		HIGH = 0,
+		NORMAL,
+		LOW,
+	};
+
+	// Per-priority queues; not synchronized. Within a level, tasks with a deadline run first in
+	// earliest-deadline order, then the rest in FIFO order. A non-empty level that has been passed
+	// over starvationLimit times is served next, even if higher levels still hold work; likewise
+	// the FIFO tasks of a level after starvationLimit deadline tasks ran ahead of them.
+	template <typename T>
+	class PriorityTaskQueue {
+	public:
+		using Clock = std::chrono::steady_clock;
+		static constexpr std::size_t LEVELS = static_cast<std::size_t>(TaskPriority::LOW) + 1;
+		static constexpr std::size_t DEFAULT_STARVATION_LIMIT = 32;
+		static constexpr Clock::time_point NO_DEADLINE = Clock::time_point::max();
+	private:
+		struct _DeadlineTask {
+			Clock::time_point deadline;
+			uint64_t sequence;
+			T task;
+		};
+
+		struct _Level {
+			std::deque<T> fifo{};
+			std::vector<_DeadlineTask> deadlines{};
+			std::size_t skipped{ 0 };
+			std::size_t fifoSkipped{ 0 };
+
+			std::size_t Size() const { return fifo.size() + deadlines.size(); }
+			bool Empty() const { return fifo.empty() && deadlines.empty(); }
+		};
+
+		static bool _Later(const _DeadlineTask &a, const _DeadlineTask &b) {
+			return a.deadline != b.deadline ? a.deadline > b.deadline : a.sequence > b.sequence;
+		}
+
+		std::array<_Level, LEVELS> _levels{};
+		std::size_t _size{ 0 };
+		uint64_t _sequence{ 0 };
+		std::size_t _starvationLimit{ DEFAULT_STARVATION_LIMIT };
+
+		std::size_t _SelectLevel() {
+			std::size_t selected = LEVELS;
+			for (std::size_t level = 0; level < LEVELS; level++) {
+				if (_levels[level].Empty()) {
+					continue;
+				}
+				if (selected == LEVELS) {
+					selected = level;
+				} else if (_levels[level].skipped >= _starvationLimit) {
+					selected = level;
+					break;
+				}
+			}
+			for (std::size_t level = selected + 1; level < LEVELS; level++) {
+				if (!_levels[level].Empty()) {
+					_levels[level].skipped++;
+				}
+			}
+			_levels[selected].skipped = 0;
+			return selected;
+		}
+	public:
+		explicit PriorityTaskQueue(std::size_t starvationLimit = DEFAULT_STARVATION_LIMIT) :
+			_starvationLimit(std::max<std::size_t>(starvationLimit, 1)) {}
+
+		void Push(T &&task, TaskPriority priority = TaskPriority::NORMAL, Clock::time_point deadline = NO_DEADLINE) {
+			_Level &level = _levels[static_cast<std::size_t>(priority)];
+			if (deadline == NO_DEADLINE) {
+				level.fifo.push_back(std::move(task));
+			} else {
+				level.deadlines.push_back({ deadline, _sequence++, std::move(task) });
+				std::push_heap(level.deadlines.begin(), level.deadlines.end(), &_Later);
+			}
+			_size++;
+		}
+
+		// Must only be called when the queue is not empty.
+		std::pair<T, TaskPriority> Pop() {
+			std::size_t selected = _SelectLevel();
+			_Level &level = _levels[selected];
+			T task;
+			if (!level.deadlines.empty() && (level.fifo.empty() || level.fifoSkipped < _starvationLimit)) {
+				if (!level.fifo.empty()) {
+					level.fifoSkipped++;
+				}
+				std::pop_heap(level.deadlines.begin(), level.deadlines.end(), &_Later);
+				task = std::move(level.deadlines.back().task);
+				level.deadlines.pop_back();
+			} else {
+				task = std::move(level.fifo.front());
+				level.fifo.pop_front();
+				level.fifoSkipped = 0;
+			}
+			_size--;
+			return { std::move(task), static_cast<TaskPriority>(selected) };
+		}
+
+		bool Empty() const { return _size == 0; }
+		std::size_t Size() const { return _size; }
+
+		std::size_t Size(TaskPriority priority) const {
+			return _levels[static_cast<std::size_t>(priority)].Size();
+		}
+
+		void Clear() {
+			for (auto &level : _levels) {
+				level = _Level{};
+			}
+			_size = 0;
+		}
+	};
+} // namespace Framework::Task
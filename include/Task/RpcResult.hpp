@@ -0,0 +1,60 @@
+#pragma once
+
+#include <exception>
+#include <optional>
+#include <utility>
+
+#include "Exception/Exception.hpp"
+
+namespace Framework::Task {
+	using namespace Framework;
+
+	// Outcome of a typed RpcEvent: the handler's value (if it produced one) and how the call ended.
+	template <typename V>
+	class RpcResult {
+		Error::Code _code{ Error::Code::Unknown };
+		std::optional<V> _value{};
+		std::exception_ptr _exception{};
+
+		void _RethrowIfFailed() const {
+			if (_exception) {
+				std::rethrow_exception(_exception);
+			}
+			if (!_value) {
+				throw Exception("RPC produced no result", _code);
+			}
+		}
+	public:
+		RpcResult(Error::Code code, std::optional<V> &&value = std::nullopt) :
+			_code(code), _value(std::move(value)) {}
+
+		// Carries an exception thrown by the handler to an asynchronous caller.
+		explicit RpcResult(std::exception_ptr exception) : _exception(exception) {}
+
+		static RpcResult FromResponse(bool handled, std::optional<V> &&value) {
+			if (!handled) {
+				return { Error::Code::Rejected, std::move(value) };
+			}
+			if (!value) {
+				return { Error::Code::NoResult };
+			}
+			return { Error::Code::Success, std::move(value) };
+		}
+
+		Error::Code GetCode() const { return _code; }
+		bool IsSuccess() const { return _code == Error::Code::Success; }
+		bool HasValue() const { return _value.has_value(); }
+		explicit operator bool() const { return IsSuccess(); }
+		const std::exception_ptr &GetException() const { return _exception; }
+
+		const V &Value() const & {
+			_RethrowIfFailed();
+			return *_value;
+		}
+
+		V &&Value() && {
+			_RethrowIfFailed();
+			return std::move(*_value);
+		}
+	};
+} // namespace Framework::Task
@@ -14,12 +14,12 @@
 namespace Framework::Task {
 
 	template <typename T = EventRequest<>::Command,
-		typename U = MessageEventAggregator<>::State>
-	class StateMachine : public EventTaskBase<T>::EventAggregator {
+		typename U = MessageEventAggregator<>::State, typename R = EventRequest<T>>
+	class StateMachine : public EventTaskBase<T, R>::EventAggregator {
 	public:
 		using Command = T;
 		using State = U;
-		using EventAggregator = MessageEventAggregator<Command, State>;
+		using EventAggregator = MessageEventAggregator<Command, State, R>;
 		using StateTable =
 			std::map<State, EventAggregator>;
 		using StateEvents =
@@ -58,11 +58,35 @@ namespace Framework::Task {
 
 		State GetState() const { return _current.load().state; }
 
-		bool Publish(EventRequest<Command>::Command command, const MessageEventArgs<Command> &args) override {
+		void SetFallbackHandler(const typename EventAggregator::EventHandler &handler) {
+			for (auto &[state, aggregator] : _table) {
+				aggregator.SetFallbackHandler(handler);
+			}
+		}
+
+		void SetUnhandledPolicy(typename EventAggregator::UnhandledPolicy policy) {
+			for (auto &[state, aggregator] : _table) {
+				aggregator.SetUnhandledPolicy(policy);
+			}
+		}
+
+		uint64_t CountUnhandledEvents() const {
+			uint64_t count = 0;
+			for (const auto &[state, aggregator] : _table) {
+				count += aggregator.CountUnhandledEvents();
+			}
+			return count;
+		}
+
+		bool Publish(Command command, const MessageEventArgs<Command, R> &args) override {
 			auto current = _current.load();
-			const bool returnValue = current.aggregator->Publish(command, args);
-			State nextState = current.aggregator->GetNextState(command);
-			if ((nextState != MessageEventAggregator<Command, State>::KEEP_STATE) && returnValue) {
+			const auto *info = current.aggregator->Find(command);
+			if (__Unlikely(!info)) {
+				return current.aggregator->PublishUnhandled(args);
+			}
+			const bool returnValue = info->Handle(args);
+			State nextState = info->GetNextState();
+			if ((nextState != EventAggregator::KEEP_STATE) && returnValue) {
 				SetState(nextState);
 			}
 			return returnValue;
@@ -10,14 +10,15 @@ namespace Framework::Task {
 
 	template <typename T = StateMachine<>::State,
 		typename U = StateMachine<>::Command,
+		typename R = EventRequest<U>,
 		std::enable_if_t<(std::is_integral_v<T> || std::is_enum_v<T>) &&
 		(std::is_integral_v<U> || std::is_enum_v<U>), nullptr_t> = nullptr>
-	class StatementTask : public EventTaskBase<U> {
+	class StatementTask : public EventTaskBase<U, R> {
 	public:
 		using State = T;
 		using Command = U;
 
-		using StateMachine = class StateMachine<Command, State>;
+		using StateMachine = class StateMachine<Command, State, R>;
 		using StateTable = typename StateMachine::StateTable;
 		using StateEvents = typename StateMachine::StateEvents;
 
@@ -25,11 +26,18 @@ namespace Framework::Task {
 		using EventHandler = typename Events::EventHandler;
 		static constexpr State KEEP_STATE = Events::KEEP_STATE;
 	private:
-		using _Base = EventTaskBase<Command>;
+		using _Base = EventTaskBase<Command, R>;
 		StateMachine _stateMachine;
 	public:
-		StatementTask(const std::string &name, const StateTable &table, State initialState)
-			: _Base(TaskType::STATEMENT, name, &_stateMachine),
+		StatementTask(const std::string &name, const StateTable &table, State initialState,
+			typename _Base::QueueType queueType = _Base::QueueType::SYNCHRONIZED_DEQUE)
+			: _Base(TaskType::STATEMENT, name, &_stateMachine, queueType),
+			_stateMachine(table, initialState) {}
+
+		// Runs the task's events on executor's workers instead of a dedicated thread.
+		StatementTask(const std::string &name, const StateTable &table, State initialState,
+			TaskPool &executor, const typename _Base::Mailbox &mailbox = {})
+			: _Base(TaskType::STATEMENT, name, &_stateMachine, mailbox, &executor),
 			_stateMachine(table, initialState) {}
 
 		void SetState(State newState) {
@@ -40,6 +48,10 @@ namespace Framework::Task {
 			return _stateMachine.GetState();
 		}
 
+		StateMachine &GetStateMachine() {
+			return _stateMachine;
+		}
+
 		ReferenceProperty::FunctionSetter<void(State, State)> stateChanged{ _stateMachine.stateChanged };
 	};
 
@@ -5,6 +5,7 @@
 #include <thread>
 #include "Main/Workspace.hpp"
 #include "Main/Config.hpp"
+#include "Task/TaskRegistry.hpp"
 
 namespace Framework::Task {
 
@@ -21,12 +22,14 @@ namespace Framework::Task {
 		std::string name;
 		TaskType type;
 		std::thread::id threadId;
+		TaskId id;
 	};
 
 	class TaskBase {
 	protected:
 		std::string _name;
 		TaskType _type { TaskType::UNKNOWN };
+		TaskId _id;
 		Main::Workspace _workspace;
 		std::thread _thread;
 	private:
@@ -36,16 +39,22 @@ namespace Framework::Task {
 		}
 	public:
 		TaskBase(TaskType type, const std::string &name)
-			: _name(name), _type{ type }, _workspace{ _BuildWorkspacePath(name) } {
+			: _name(name), _type{ type }, _id{ TaskRegistry::Register(name) },
+			_workspace{ _BuildWorkspacePath(name) } {
 			_workspace.Create();
 		}
 
 		~TaskBase() {
 			_workspace.Remove();
+			TaskRegistry::Unregister(_id);
+		}
+
+		TaskId GetId() const {
+			return _id;
 		}
 
 		virtual TaskInfomation GetTaskInfomation() {
-			return { _name, _type, _thread.get_id() };
+			return { _name, _type, _thread.get_id(), _id };
 		}
 	};
 } // namespace Framework::Task
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace Framework::Task {
+	// Schedules a continuation; an empty executor runs continuations inline on the completing thread.
+	using TaskExecutor = std::function<void(std::function<void()>)>;
+
+	template <typename V>
+	class TaskFuture;
+
+	// Shared state between a running task and its future. Completed once; the value is consumed once.
+	template <typename V>
+	class FutureState {
+		using Value = std::conditional_t<std::is_void_v<V>, std::monostate, V>;
+
+		std::mutex _mutex{};
+		std::condition_variable _condition{};
+		std::optional<Value> _value{};
+		std::exception_ptr _exception{};
+		bool _ready{ false };
+		std::vector<std::function<void()>> _continuations{};
+		const TaskExecutor _executor;
+
+		void _Complete() {
+			std::vector<std::function<void()>> continuations;
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_ready = true;
+				continuations.swap(_continuations);
+			}
+			_condition.notify_all();
+			for (auto &continuation : continuations) {
+				continuation();
+			}
+		}
+	public:
+		explicit FutureState(TaskExecutor executor = {}) : _executor(std::move(executor)) {}
+
+		template <typename... U>
+		void SetValue(U &&...value) {
+			_value.emplace(std::forward<U>(value)...);
+			_Complete();
+		}
+
+		void SetException(std::exception_ptr exception) {
+			_exception = exception;
+			_Complete();
+		}
+
+		// Completes the state with the outcome of callable, capturing any exception it throws.
+		template <typename F>
+		void Run(F &&callable) {
+			try {
+				if constexpr (std::is_void_v<V>) {
+					std::forward<F>(callable)();
+					SetValue();
+				} else {
+					SetValue(std::forward<F>(callable)());
+				}
+			} catch (...) {
+				SetException(std::current_exception());
+			}
+		}
+
+		// Runs continuation on the completing thread, or immediately when already complete.
+		void OnReady(std::function<void()> continuation) {
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				if (!_ready) {
+					_continuations.push_back(std::move(continuation));
+					return;
+				}
+			}
+			continuation();
+		}
+
+		void Schedule(std::function<void()> task) const {
+			if (_executor) {
+				_executor(std::move(task));
+			} else {
+				task();
+			}
+		}
+
+		const TaskExecutor &GetExecutor() const { return _executor; }
+
+		bool IsReady() {
+			std::lock_guard<std::mutex> lock(_mutex);
+			return _ready;
+		}
+
+		void Wait() {
+			std::unique_lock<std::mutex> lock(_mutex);
+			_condition.wait(lock, [this] { return _ready; });
+		}
+
+		// Must only be called once the state is ready; rethrows the task's exception.
+		V TakeValue() {
+			if (_exception) {
+				std::rethrow_exception(_exception);
+			}
+			if constexpr (!std::is_void_v<V>) {
+				return std::move(*_value);
+			}
+		}
+	};
+
+	// Lightweight future returned by TaskPool::Submit. Either Get or Then consumes the result, not both.
+	template <typename V>
+	class TaskFuture {
+		std::shared_ptr<FutureState<V>> _state;
+
+		template <typename U>
+		friend class TaskFuture;
+	public:
+		using ValueType = V;
+
+		TaskFuture() = default;
+		explicit TaskFuture(std::shared_ptr<FutureState<V>> state) : _state(std::move(state)) {}
+
+		bool IsValid() const { return _state != nullptr; }
+		bool IsReady() const { return _state->IsReady(); }
+		void Wait() const { _state->Wait(); }
+
+		V Get() {
+			_state->Wait();
+			return _state->TakeValue();
+		}
+
+		// Schedules f with this future's value (nothing for void) on the executor once it is ready.
+		// An exception from this future skips f and propagates to the returned future.
+		template <typename F>
+		auto Then(F &&f) {
+			using R = std::conditional_t<std::is_void_v<V>,
+				std::invoke_result<std::decay_t<F>>, std::invoke_result<std::decay_t<F>, V>>::type;
+			auto next = std::make_shared<FutureState<R>>(_state->GetExecutor());
+			_state->OnReady([state = _state, next, f = std::forward<F>(f)]() mutable {
+				state->Schedule([state, next, f = std::move(f)]() mutable {
+					next->Run([&]() -> R {
+						if constexpr (std::is_void_v<V>) {
+							state->TakeValue();
+							return f();
+						} else {
+							return f(state->TakeValue());
+						}
+					});
+				});
+			});
+			return TaskFuture<R>(std::move(next));
+		}
+
+		// Ready once every input is; holds all values in input order, or the first exception seen.
+		friend auto WhenAll(std::vector<TaskFuture> futures) {
+			using R = std::conditional_t<std::is_void_v<V>, void, std::vector<V>>;
+			auto result = std::make_shared<FutureState<R>>(
+				futures.empty() ? TaskExecutor{} : futures.front()._state->GetExecutor());
+			if (futures.empty()) {
+				result->Run([]() -> R { return R(); });
+				return TaskFuture<R>(std::move(result));
+			}
+			auto inputs = std::make_shared<std::vector<TaskFuture>>(std::move(futures));
+			auto remaining = std::make_shared<std::atomic<std::size_t>>(inputs->size());
+			for (auto &input : *inputs) {
+				input._state->OnReady([inputs, remaining, result] {
+					if (remaining->fetch_sub(1, std::memory_order_acq_rel) != 1) {
+						return;
+					}
+					result->Run([&]() -> R {
+						if constexpr (std::is_void_v<V>) {
+							for (auto &future : *inputs) {
+								future._state->TakeValue();
+							}
+						} else {
+							R values;
+							values.reserve(inputs->size());
+							for (auto &future : *inputs) {
+								values.push_back(future._state->TakeValue());
+							}
+							return values;
+						}
+					});
+				});
+			}
+			return TaskFuture<R>(std::move(result));
+		}
+
+		// Ready with the index of the first input to complete; that input still holds its result.
+		// Never becomes ready for an empty input.
+		friend TaskFuture<std::size_t> WhenAny(const std::vector<TaskFuture> &futures) {
+			auto result = std::make_shared<FutureState<std::size_t>>(
+				futures.empty() ? TaskExecutor{} : futures.front()._state->GetExecutor());
+			auto claimed = std::make_shared<std::atomic<bool>>(false);
+			for (std::size_t i = 0; i < futures.size(); i++) {
+				futures[i]._state->OnReady([result, claimed, i] {
+					if (!claimed->exchange(true, std::memory_order_acq_rel)) {
+						result->SetValue(i);
+					}
+				});
+			}
+			return TaskFuture<std::size_t>(std::move(result));
+		}
+	};
+} // namespace Framework::Task
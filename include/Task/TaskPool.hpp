@@ -12,26 +12,173 @@
 #include <condition_variable>
 #include <mutex>
 #include <atomic>
+#include <memory>
+#include <optional>
+#include <array>
+#include <chrono>
+#include <iterator>
 
 #include "Task/TaskBase.hpp"
+#include "Task/Cancellation.hpp"
+#include "Task/TaskFuture.hpp"
+#include "Task/CpuTopology.hpp"
+#include "Task/PriorityTaskQueue.hpp"
+#include "Sync/WorkStealingDeque.hpp"
+#include "Metrics/Histogram.hpp"
 
 namespace Framework::Task {
 
 	class TaskPool : public TaskBase {
 		using Task = std::function<void()>;
-	private:	
-		std::deque<std::function<void()>> _tasks{};
+
+		struct _Job {
+			Task task{};
+			std::chrono::steady_clock::time_point enqueued{};
+		};
+
+		using TaskQueue = PriorityTaskQueue<_Job>;
+	public:
+		using Priority = TaskPriority;
+		using Clock = TaskQueue::Clock;
+		static constexpr Clock::time_point NO_DEADLINE = TaskQueue::NO_DEADLINE;
+
+		enum class Scheduler : uint8_t {
+			SHARED_QUEUE = 0,
+			// Per-worker deques: tasks enqueued from a worker stay on that worker, idle workers steal.
+			WORK_STEALING,
+		};
+
+		struct Options {
+			// 0 uses the size of the affinity mask.
+			size_t concurrency{ 0 };
+			Scheduler scheduler{ Scheduler::SHARED_QUEUE };
+			// Pins worker i to the i-th CPU of the affinity mask.
+			bool pinWorkers{ false };
+			// Keeps each worker on its NUMA node; work-stealing workers steal within their node first.
+			bool numaAware{ false };
+			// A waiting priority level passed over this many times in a row is served next; so are the
+			// FIFO tasks of a level after this many deadline tasks ran ahead of them.
+			size_t starvationLimit{ TaskQueue::DEFAULT_STARVATION_LIMIT };
+			// Above concurrency, the shared-queue scheduler grows up to this many workers under load
+			// and retires the extra ones after idleTimeout without work; 0 never retires them.
+			size_t maxConcurrency{ 0 };
+			std::chrono::milliseconds idleTimeout{ std::chrono::seconds(60) };
+			// Backlog at which Enqueue adds a worker when none is idle.
+			size_t growThreshold{ 1 };
+			// Collects per-worker counters and queue-wait / execution-time histograms.
+			bool statistics{ false };
+		};
+
+		// Histograms are in nanoseconds.
+		struct WorkerStatistics {
+			size_t executedTasks{ 0 };
+			size_t stealAttempts{ 0 };
+			size_t steals{ 0 };
+			size_t wakeups{ 0 };
+			std::chrono::nanoseconds idleTime{ 0 };
+			Metrics::HistogramSnapshot queueWait{};
+			Metrics::HistogramSnapshot execution{};
+		};
+
+		struct Placement {
+			int cpu{ -1 };
+			int node{ 0 };
+		};
+	private:
+		struct _Worker {
+			Sync::WorkStealingDeque<_Job *> tasks{};
+			uint64_t seed{ 0 };
+			int node{ 0 };
+		};
+
+		// Shared with the executors of futures, which may outlive the pool. pool is cleared by Stop,
+		// which then waits until no executor is still inside Enqueue.
+		struct _Lifetime {
+			std::atomic<TaskPool *> pool{ nullptr };
+			std::atomic<size_t> enqueuing{ 0 };
+		};
+
+		struct alignas(64) _Statistics {
+			std::atomic<size_t> executedTasks{ 0 };
+			std::atomic<size_t> stealAttempts{ 0 };
+			std::atomic<size_t> steals{ 0 };
+			std::atomic<size_t> wakeups{ 0 };
+			std::atomic<int64_t> idleNanoseconds{ 0 };
+			Metrics::Histogram<> queueWait{};
+			Metrics::Histogram<> execution{};
+		};
+
+		TaskQueue _tasks{};
 		std::condition_variable _condition{};
 		std::mutex _mutex{};
 		std::vector<std::thread> _workers{};
-		bool _stop {false};
+		std::atomic<bool> _stop {false};
 		size_t _concurrency {0};
 		std::atomic<size_t> _runningTasks {0};
+		std::atomic<size_t> _pendingTasks {0};
+		std::atomic<size_t> _cancelledTasks {0};
+		std::condition_variable _drainCondition{};
+		std::array<std::atomic<size_t>, TaskQueue::LEVELS> _dispatchedTasks{};
+		const Scheduler _scheduler{ Scheduler::SHARED_QUEUE };
+		std::vector<std::unique_ptr<_Worker>> _localQueues{};
+		std::atomic<size_t> _injectedTasks{ 0 };
+		std::atomic<size_t> _sleepingWorkers{ 0 };
+		std::vector<Placement> _placements{};
+		std::vector<std::vector<int>> _placementCpus{};
+		bool _crossNode{ false };
+		size_t _maxConcurrency{ 0 };
+		std::chrono::milliseconds _idleTimeout{ 0 };
+		size_t _growThreshold{ 1 };
+		size_t _liveWorkers{ 0 };
+		size_t _idleWorkers{ 0 };
+		size_t _blockedWorkers{ 0 };
+		std::vector<size_t> _retiredWorkers{};
+		std::vector<std::unique_ptr<_Statistics>> _statistics{};
+		const std::shared_ptr<_Lifetime> _lifetime{ std::make_shared<_Lifetime>() };
 
 	public:
-		TaskPool(const std::string &name, size_t concurrency = TaskPool::_GetConcurrency())
-			: TaskBase(TaskType::TASK_POOL, name), _concurrency{concurrency} {
-			_SpawnWorkers();
+		// Marks the calling task as blocked; an elastic pool may add a worker to keep its parallelism.
+		class BlockingScope {
+			TaskPool *_pool;
+		public:
+			explicit BlockingScope(TaskPool &pool) : _pool(&pool) {
+				std::lock_guard<std::mutex> lock(_pool->_mutex);
+				_pool->_blockedWorkers++;
+				if (_pool->_idleWorkers == 0 && _pool->_liveWorkers < _pool->_concurrency + _pool->_blockedWorkers) {
+					_pool->_Grow();
+				}
+			}
+			BlockingScope(const BlockingScope &) = delete;
+			BlockingScope &operator=(const BlockingScope &) = delete;
+
+			~BlockingScope() {
+				std::lock_guard<std::mutex> lock(_pool->_mutex);
+				_pool->_blockedWorkers--;
+			}
+		};
+
+		TaskPool(const std::string &name, size_t concurrency = TaskPool::_GetConcurrency(),
+			Scheduler scheduler = Scheduler::SHARED_QUEUE)
+			: TaskPool(name, Options{ concurrency, scheduler }) {}
+
+		TaskPool(const std::string &name, const Options &options)
+			: TaskBase(TaskType::TASK_POOL, name), _tasks{ options.starvationLimit },
+			_concurrency{ options.concurrency == 0 ? _GetConcurrency() : options.concurrency },
+			_scheduler{ options.scheduler },
+			_maxConcurrency{ std::max(options.maxConcurrency, _concurrency) },
+			_idleTimeout{ options.idleTimeout }, _growThreshold{ std::max<size_t>(options.growThreshold, 1) } {
+			_lifetime->pool = this;
+			_PlanPlacement(options);
+			if (options.statistics) {
+				for (size_t i = 0; i < _maxConcurrency; i++) {
+					_statistics.push_back(std::make_unique<_Statistics>());
+				}
+			}
+			if (_scheduler == Scheduler::WORK_STEALING) {
+				_SpawnStealingWorkers();
+			} else {
+				_SpawnWorkers();
+			}
 		}
 
 		~TaskPool() {
@@ -39,75 +186,548 @@ namespace Framework::Task {
 		}
 
 		void Enqueue(Task task) {
+			Enqueue(std::move(task), Priority::NORMAL);
+		}
+
+		// Higher levels run first; within a level, tasks with a deadline run earliest-deadline first.
+		void Enqueue(Task task, Priority priority, Clock::time_point deadline = NO_DEADLINE) {
+			if (_scheduler == Scheduler::WORK_STEALING) {
+				_EnqueueStealing(std::move(task), priority, deadline);
+				return;
+			}
+			_pendingTasks.fetch_add(1, std::memory_order_relaxed);
 			std::lock_guard<std::mutex> lock(_mutex);
-			_tasks.emplace_back(std::move(task));
-			_condition.notify_all();
+			_tasks.Push(_MakeJob(std::move(task)), priority, deadline);
+			if (_idleWorkers == 0 && _tasks.Size() >= _growThreshold) {
+				_Grow();
+			}
+			_condition.notify_one();
+		}
+
+		// Skips the task if token is cancelled by the time a worker picks it up; long tasks
+		// should also poll the token themselves.
+		void Enqueue(Task task, CancellationToken token, Priority priority = Priority::NORMAL) {
+			Enqueue([this, task = std::move(task), token = std::move(token)] {
+				if (token.IsCancelled()) {
+					_cancelledTasks.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+				task();
+			}, priority);
+		}
+
+		// Enqueues every task of range under one lock, waking at most one idle worker per task.
+		template <typename Range>
+		void EnqueueBulk(Range &&tasks, Priority priority = Priority::NORMAL) {
+			auto begin = std::begin(tasks);
+			auto end = std::end(tasks);
+			size_t count = static_cast<size_t>(std::distance(begin, end));
+			if (count == 0) {
+				return;
+			}
+			_pendingTasks.fetch_add(count, std::memory_order_relaxed);
+			auto take = [](auto &task) -> Task {
+				if constexpr (std::is_lvalue_reference_v<Range>) {
+					return Task(task);
+				} else {
+					return Task(std::move(task));
+				}
+			};
+			auto [pool, index] = _CurrentWorker();
+			if (_scheduler == Scheduler::WORK_STEALING && pool == this && priority == Priority::NORMAL) {
+				for (auto it = begin; it != end; ++it) {
+					_localQueues[index]->tasks.Push(new _Job(_MakeJob(take(*it))));
+				}
+				_Wake(count);
+				return;
+			}
+			std::unique_lock<std::mutex> lock(_mutex);
+			for (auto it = begin; it != end; ++it) {
+				_tasks.Push(_MakeJob(take(*it)), priority);
+			}
+			if (_scheduler == Scheduler::WORK_STEALING) {
+				_injectedTasks.fetch_add(count, std::memory_order_relaxed);
+				lock.unlock();
+				_Wake(count);
+				return;
+			}
+			if (_idleWorkers == 0 && _tasks.Size() >= _growThreshold) {
+				_Grow();
+			}
+			_NotifyIdle(count);
+		}
+
+		// Runs f(args...) on the pool; continuations attached with Then are scheduled back onto the pool.
+		// Once the pool is stopped or destroyed, f and continuations run inline on the calling thread.
+		template <typename F, typename... Args>
+		auto Submit(F &&f, Args &&...args) {
+			using V = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>;
+			auto state = std::make_shared<FutureState<V>>(
+				[lifetime = _lifetime](std::function<void()> task) {
+					lifetime->enqueuing.fetch_add(1);
+					if (auto pool = lifetime->pool.load()) {
+						pool->Enqueue(std::move(task));
+						_LeaveEnqueue(*lifetime);
+						return;
+					}
+					_LeaveEnqueue(*lifetime);
+					task();
+				});
+			state->Schedule([state, f = std::forward<F>(f), ...args = std::forward<Args>(args)]() mutable {
+				state->Run([&]() -> V {
+					return std::invoke(std::move(f), std::move(args)...);
+				});
+			});
+			return TaskFuture<V>(std::move(state));
 		}
 
+		// Workers finish what is queued when they look and exit; tasks enqueued later by still-running
+		// tasks may be discarded. Use Drain to wait for the whole task tree.
 		void Stop() {
-			_stop = true;
+			_lifetime->pool.store(nullptr);
+			for (auto enqueuing = _lifetime->enqueuing.load(); enqueuing != 0; enqueuing = _lifetime->enqueuing.load()) {
+				_lifetime->enqueuing.wait(enqueuing);
+			}
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_stop = true;
+			}
 			_condition.notify_all();
+			_drainCondition.notify_all();
 			for (auto &worker : _workers) {
 				if (worker.joinable()) {
 					worker.join();
 				}
 			}
 			_workers.clear();
+			_FinishTasks(_DiscardLocalTasks());
+		}
+
+		// Waits until every enqueued task, including tasks enqueued by running tasks, has finished,
+		// then stops the pool.
+		void Drain() {
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_drainCondition.wait(lock, [this] {
+					return _pendingTasks.load(std::memory_order_acquire) == 0 || _stop;
+				});
+			}
+			Stop();
 		}
 
 		size_t Concurrency() const {
 			return _concurrency;
 		}
 
+		size_t MaxConcurrency() const {
+			return _maxConcurrency;
+		}
+
+		// Workers currently alive; differs from Concurrency only for an elastic pool.
+		size_t CountWorkers() {
+			std::lock_guard<std::mutex> lock(_mutex);
+			return _liveWorkers;
+		}
+
+		Scheduler GetScheduler() const {
+			return _scheduler;
+		}
+
+		// CPU (-1 when unpinned) and NUMA node chosen for worker index.
+		Placement GetPlacement(size_t index) const {
+			return index < _placements.size() ? _placements[index] : Placement{};
+		}
+
 		size_t CountWaitingTasks() {
+			size_t count = 0;
+			for (auto &worker : _localQueues) {
+				count += worker->tasks.Size();
+			}
+			std::lock_guard<std::mutex> lock(_mutex);
+			return count + _tasks.Size();
+		}
+
+		// Tasks enqueued from inside the work-stealing pool at NORMAL priority are counted as NORMAL.
+		size_t CountWaitingTasks(Priority priority) {
+			size_t count = 0;
+			if (priority == Priority::NORMAL) {
+				for (auto &worker : _localQueues) {
+					count += worker->tasks.Size();
+				}
+			}
 			std::lock_guard<std::mutex> lock(_mutex);
-			return _tasks.size();
+			return count + _tasks.Size(priority);
+		}
+
+		// Tasks taken off the queues so far at priority.
+		size_t CountDispatchedTasks(Priority priority) const {
+			return _dispatchedTasks[static_cast<size_t>(priority)].load(std::memory_order_relaxed);
 		}
 
 		size_t CountRunningTasks() {
 			return _runningTasks;
 		}
 
+		// Tasks skipped because their cancellation token was cancelled before they ran.
+		size_t CountCancelledTasks() const {
+			return _cancelledTasks.load(std::memory_order_relaxed);
+		}
+
 		void ClearWaitingTasks() {
-			std::lock_guard<std::mutex> lock(_mutex);
-			_tasks.clear();
+			size_t cleared = _DiscardLocalTasks();
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				cleared += _tasks.Size();
+				_tasks.Clear();
+				_injectedTasks = 0;
+			}
+			_FinishTasks(cleared);
 		}
 
 		bool IsEmpty() {
-			std::lock_guard<std::mutex> lock(_mutex);
-			return _tasks.empty();
+			return CountWaitingTasks() == 0;
+		}
+
+		// Per-worker statistics, readable while the pool runs; empty unless Options::statistics is set.
+		std::vector<WorkerStatistics> GetWorkerStatistics() const {
+			std::vector<WorkerStatistics> workers;
+			for (auto &statistics : _statistics) {
+				WorkerStatistics worker;
+				worker.executedTasks = statistics->executedTasks.load(std::memory_order_relaxed);
+				worker.stealAttempts = statistics->stealAttempts.load(std::memory_order_relaxed);
+				worker.steals = statistics->steals.load(std::memory_order_relaxed);
+				worker.wakeups = statistics->wakeups.load(std::memory_order_relaxed);
+				worker.idleTime = std::chrono::nanoseconds(statistics->idleNanoseconds.load(std::memory_order_relaxed));
+				worker.queueWait = statistics->queueWait.Snapshot();
+				worker.execution = statistics->execution.Snapshot();
+				workers.push_back(std::move(worker));
+			}
+			return workers;
+		}
+
+		// Sum of GetWorkerStatistics over all workers.
+		WorkerStatistics GetStatistics() const {
+			WorkerStatistics total;
+			for (auto &worker : GetWorkerStatistics()) {
+				total.executedTasks += worker.executedTasks;
+				total.stealAttempts += worker.stealAttempts;
+				total.steals += worker.steals;
+				total.wakeups += worker.wakeups;
+				total.idleTime += worker.idleTime;
+				total.queueWait.Merge(worker.queueWait);
+				total.execution.Merge(worker.execution);
+			}
+			return total;
 		}
 
 	private:
+		// Only a Stop that has already cleared pool waits on the count, so only then is it woken.
+		static void _LeaveEnqueue(_Lifetime &lifetime) {
+			if (lifetime.enqueuing.fetch_sub(1) == 1 && !lifetime.pool.load()) {
+				lifetime.enqueuing.notify_all();
+			}
+		}
+
 		void _SpawnWorkers() {
+			std::lock_guard<std::mutex> lock(_mutex);
 			for (size_t i = 0; i < _concurrency; i++) {
-				_workers.emplace_back(std::thread {[this] {
-					while (true) {
-						auto task =_WaitForNewTask();
-						if (_stop && !task) {
-							return;
-						}
-						if (task) {
-							_runningTasks++;
-							task();
-							_runningTasks--;
-						}
+				_workers.emplace_back(_StartWorker(i));
+			}
+			_liveWorkers = _concurrency;
+		}
+
+		std::thread _StartWorker(size_t index) {
+			return std::thread {[this, index] {
+				_ApplyPlacement(index);
+				while (auto job = _WaitForNewTask(index)) {
+					_Execute(index, *job);
+				}
+			}};
+		}
+
+		bool _IsElastic() const {
+			return _scheduler == Scheduler::SHARED_QUEUE && _maxConcurrency > _concurrency;
+		}
+
+		// Adds a shared-queue worker, reusing the slot of a retired one; _mutex must be held.
+		void _Grow() {
+			if (!_IsElastic() || _stop || _liveWorkers >= _maxConcurrency) {
+				return;
+			}
+			if (_retiredWorkers.empty()) {
+				_workers.emplace_back(_StartWorker(_workers.size()));
+			} else {
+				size_t index = _retiredWorkers.back();
+				_retiredWorkers.pop_back();
+				_workers[index].join();
+				_workers[index] = _StartWorker(index);
+			}
+			_liveWorkers++;
+		}
+
+		void _SpawnStealingWorkers() {
+			for (size_t i = 0; i < _concurrency; i++) {
+				_localQueues.push_back(std::make_unique<_Worker>());
+				_localQueues.back()->seed = 0x9E3779B97F4A7C15ull * (i + 1);
+				_localQueues.back()->node = GetPlacement(i).node;
+			}
+			_liveWorkers = _concurrency;
+			for (size_t i = 0; i < _concurrency; i++) {
+				_workers.emplace_back(std::thread {[this, i] {
+					_ApplyPlacement(i);
+					_CurrentWorker() = { this, i };
+					while (auto job = _WaitForStealableTask(i)) {
+						_Execute(i, *job);
+						delete job;
 					}
+					_CurrentWorker() = { nullptr, 0 };
 				}});
 			}
 		}
 
-		Task _WaitForNewTask() {
+		// Only plain NORMAL tasks from a worker stay local; everything else is ordered by the shared queue.
+		void _EnqueueStealing(Task &&task, Priority priority, Clock::time_point deadline) {
+			_pendingTasks.fetch_add(1, std::memory_order_relaxed);
+			auto [pool, index] = _CurrentWorker();
+			if (pool == this && priority == Priority::NORMAL && deadline == NO_DEADLINE) {
+				_localQueues[index]->tasks.Push(new _Job(_MakeJob(std::move(task))));
+			} else {
+				std::lock_guard<std::mutex> lock(_mutex);
+				_tasks.Push(_MakeJob(std::move(task)), priority, deadline);
+				_injectedTasks.fetch_add(1, std::memory_order_relaxed);
+			}
+			_Wake(1);
+		}
+
+		void _Wake(size_t count) {
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (_sleepingWorkers.load(std::memory_order_relaxed) > 0) {
+				std::lock_guard<std::mutex> lock(_mutex);
+				_NotifyIdle(count);
+			}
+		}
+
+		// Wakes one waiting worker per task, or all of them; _mutex must be held.
+		void _NotifyIdle(size_t count) {
+			size_t waiting = _scheduler == Scheduler::WORK_STEALING ?
+				_sleepingWorkers.load(std::memory_order_relaxed) : _idleWorkers;
+			if (count >= waiting) {
+				_condition.notify_all();
+				return;
+			}
+			for (size_t i = 0; i < count; i++) {
+				_condition.notify_one();
+			}
+		}
+
+		_Job _MakeJob(Task &&task) const {
+			return { std::move(task), _statistics.empty() ? Clock::time_point{} : Clock::now() };
+		}
+
+		_Statistics *_StatisticsOf(size_t index) const {
+			return index < _statistics.size() ? _statistics[index].get() : nullptr;
+		}
+
+		void _Execute(size_t index, _Job &job) {
+			_runningTasks++;
+			if (auto *statistics = _StatisticsOf(index)) {
+				auto start = Clock::now();
+				statistics->queueWait.Record(_Nanoseconds(start - job.enqueued));
+				job.task();
+				statistics->execution.Record(_Nanoseconds(Clock::now() - start));
+				statistics->executedTasks.fetch_add(1, std::memory_order_relaxed);
+			} else {
+				job.task();
+			}
+			_runningTasks--;
+			_FinishTasks(1);
+		}
+
+		// Blocks on _condition, accounting the time as idle; returns what the wait returned.
+		template <typename Wait>
+		auto _IdleWait(size_t index, Wait &&wait) {
+			auto *statistics = _StatisticsOf(index);
+			if (!statistics) {
+				return wait();
+			}
+			auto start = Clock::now();
+			auto result = wait();
+			statistics->idleNanoseconds.fetch_add(
+				static_cast<int64_t>(_Nanoseconds(Clock::now() - start)), std::memory_order_relaxed);
+			statistics->wakeups.fetch_add(1, std::memory_order_relaxed);
+			return result;
+		}
+
+		static uint64_t _Nanoseconds(Clock::duration duration) {
+			auto count = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+			return count > 0 ? static_cast<uint64_t>(count) : 0;
+		}
+
+		void _FinishTasks(size_t count) {
+			if (count == 0) {
+				return;
+			}
+			if (_pendingTasks.fetch_sub(count, std::memory_order_acq_rel) == count) {
+				std::lock_guard<std::mutex> lock(_mutex);
+				_drainCondition.notify_all();
+			}
+		}
+
+		// Local deque first (unless HIGH tasks are waiting), then the injection queue, then randomized
+		// stealing from the other workers, trying workers on the same NUMA node before the rest.
+		_Job *_FindTask(size_t index) {
+			_Worker &self = *_localQueues[index];
+			auto *statistics = _StatisticsOf(index);
+			if (_injectedTasks.load(std::memory_order_relaxed) > 0) {
+				std::lock_guard<std::mutex> lock(_mutex);
+				if (!_tasks.Empty() && (self.tasks.IsEmpty() || _tasks.Size(Priority::HIGH) > 0)) {
+					auto [job, priority] = _tasks.Pop();
+					_injectedTasks.fetch_sub(1, std::memory_order_relaxed);
+					_CountDispatch(priority);
+					return new _Job(std::move(job));
+				}
+			}
+			if (auto task = self.tasks.Take()) {
+				_CountDispatch(Priority::NORMAL);
+				return *task;
+			}
+			const size_t count = _localQueues.size();
+			self.seed ^= self.seed << 13;
+			self.seed ^= self.seed >> 7;
+			self.seed ^= self.seed << 17;
+			const size_t start = static_cast<size_t>(self.seed % count);
+			for (int pass = 0; pass < (_crossNode ? 2 : 1); pass++) {
+				for (size_t i = 0; i < count; i++) {
+					size_t victim = (start + i) % count;
+					if (victim == index || (_crossNode && (_localQueues[victim]->node == self.node) != (pass == 0))) {
+						continue;
+					}
+					auto task = _localQueues[victim]->tasks.Steal();
+					if (statistics) {
+						statistics->stealAttempts.fetch_add(1, std::memory_order_relaxed);
+						statistics->steals.fetch_add(task ? 1 : 0, std::memory_order_relaxed);
+					}
+					if (task) {
+						_CountDispatch(Priority::NORMAL);
+						return *task;
+					}
+				}
+			}
+			return nullptr;
+		}
+
+		bool _HasVisibleTask() {
+			if (!_tasks.Empty()) {
+				return true;
+			}
+			for (auto &worker : _localQueues) {
+				if (!worker->tasks.IsEmpty()) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		// Returns nullptr once the pool is stopped and no task is left anywhere.
+		_Job *_WaitForStealableTask(size_t index) {
+			while (true) {
+				if (auto task = _FindTask(index)) {
+					return task;
+				}
+				std::unique_lock<std::mutex> lock(_mutex);
+				_sleepingWorkers.fetch_add(1, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if (_HasVisibleTask()) {
+					_sleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+					continue;
+				}
+				if (_stop) {
+					_sleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+					return nullptr;
+				}
+				_IdleWait(index, [&] { _condition.wait(lock); return true; });
+				_sleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+			}
+		}
+
+		size_t _DiscardLocalTasks() {
+			size_t discarded = 0;
+			for (auto &worker : _localQueues) {
+				while (!worker->tasks.IsEmpty()) {
+					if (auto task = worker->tasks.Steal()) {
+						delete *task;
+						discarded++;
+					}
+				}
+			}
+			return discarded;
+		}
+
+		static std::pair<const TaskPool *, size_t> &_CurrentWorker() {
+			thread_local std::pair<const TaskPool *, size_t> current{ nullptr, 0 };
+			return current;
+		}
+
+		// Returns nothing when the worker should exit: the pool stopped or the worker retired.
+		std::optional<_Job> _WaitForNewTask(size_t index) {
 			std::unique_lock<std::mutex> lock(_mutex);
-			_condition.wait(lock, [this] {
-				return !_tasks.empty() || _stop;
-			});
-			if (_tasks.empty()) {
-				return {};
+			while (_tasks.Empty() && !_stop) {
+				_idleWorkers++;
+				if (!_IsElastic() || _idleTimeout <= std::chrono::milliseconds::zero()) {
+					_IdleWait(index, [&] { _condition.wait(lock); return true; });
+					_idleWorkers--;
+					continue;
+				}
+				auto status = _IdleWait(index, [&] { return _condition.wait_for(lock, _idleTimeout); });
+				_idleWorkers--;
+				if (status == std::cv_status::timeout && _tasks.Empty() && !_stop &&
+					_liveWorkers > _concurrency) {
+					_liveWorkers--;
+					_retiredWorkers.push_back(index);
+					return std::nullopt;
+				}
+			}
+			if (_tasks.Empty()) {
+				return std::nullopt;
+			}
+			auto [job, priority] = _tasks.Pop();
+			_CountDispatch(priority);
+			return std::move(job);
+		}
+
+		void _CountDispatch(Priority priority) {
+			_dispatchedTasks[static_cast<size_t>(priority)].fetch_add(1, std::memory_order_relaxed);
+		}
+
+		void _PlanPlacement(const Options &options) {
+			if (!options.pinWorkers && !options.numaAware) {
+				return;
+			}
+			auto topology = CpuTopology::Detect();
+			const auto &cpus = topology.Cpus();
+			if (cpus.empty()) {
+				return;
+			}
+			for (size_t i = 0; i < _concurrency; i++) {
+				int cpu = cpus[i % cpus.size()];
+				int node = topology.NodeOf(cpu);
+				_placements.push_back({ options.pinWorkers ? cpu : -1, node });
+				_placementCpus.push_back(options.pinWorkers ? std::vector<int>{ cpu } : topology.CpusOf(node));
+				_crossNode = _crossNode || node != _placements.front().node;
+			}
+			_crossNode = _crossNode && options.numaAware;
+		}
+
+		void _ApplyPlacement(size_t index) {
+			if (index >= _placementCpus.size()) {
+				return;
 			}
-			auto task = std::move(_tasks.front());
-			_tasks.pop_front();
-			return task;
+			cpu_set_t cpu_set;
+			CPU_ZERO(&cpu_set);
+			for (int cpu : _placementCpus[index]) {
+				CPU_SET(cpu, &cpu_set);
+			}
+			pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
 		}
 
 		static size_t _GetConcurrency() {
@@ -117,4 +737,11 @@ namespace Framework::Task {
 			return static_cast<size_t>(CPU_COUNT(&cpu_set));
 		}
 	};
+
+	// Pool dispatching the event task running on this thread, or nullptr on a dedicated task thread.
+	// Blocking RPCs mark themselves blocked on it, whichever task they call.
+	inline TaskPool *&CurrentExecutor() {
+		thread_local TaskPool *executor = nullptr;
+		return executor;
+	}
 } // namespace Framework::Task
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <compare>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace Framework::Task {
+
+	// Slot index plus one in the low half, generation of that slot in the high half.
+	class TaskId {
+		uint64_t _value{ 0 };
+	public:
+		constexpr TaskId() = default;
+		explicit constexpr TaskId(uint64_t value) : _value(value) {}
+		constexpr TaskId(uint32_t index, uint32_t generation) :
+			_value((static_cast<uint64_t>(generation) << 32) | (static_cast<uint64_t>(index) + 1)) {}
+
+		constexpr uint64_t Value() const { return _value; }
+		constexpr bool IsValid() const { return static_cast<uint32_t>(_value) != 0; }
+		constexpr uint32_t Index() const { return static_cast<uint32_t>(_value) - 1; }
+		constexpr uint32_t Generation() const { return static_cast<uint32_t>(_value >> 32); }
+
+		constexpr auto operator<=>(const TaskId &) const = default;
+	};
+
+	// Assigns compact identities to tasks and resolves them back to names for diagnostics.
+	// Slots of unregistered tasks are reused under a new generation, so a stale id resolves to an
+	// empty name instead of the task that took over its slot.
+	class TaskRegistry final {
+		struct _Slot {
+			std::string name;
+			uint32_t generation{ 0 };
+		};
+
+		struct _State {
+			std::shared_mutex mutex;
+			std::vector<_Slot> slots;
+			std::vector<uint32_t> free;
+		};
+
+		static _State &_GetState() {
+			static _State state;
+			return state;
+		}
+
+		static _Slot *_Find(_State &state, TaskId id) {
+			if (!id.IsValid() || id.Index() >= state.slots.size()) {
+				return nullptr;
+			}
+			_Slot &slot = state.slots[id.Index()];
+			return slot.generation == id.Generation() ? &slot : nullptr;
+		}
+	public:
+		static TaskId Register(const std::string &name) {
+			_State &state = _GetState();
+			std::lock_guard<std::shared_mutex> lock(state.mutex);
+			uint32_t index;
+			if (state.free.empty()) {
+				index = static_cast<uint32_t>(state.slots.size());
+				state.slots.emplace_back();
+			} else {
+				index = state.free.back();
+				state.free.pop_back();
+			}
+			_Slot &slot = state.slots[index];
+			slot.name = name;
+			return TaskId{ index, slot.generation };
+		}
+
+		static void Unregister(TaskId id) {
+			_State &state = _GetState();
+			std::lock_guard<std::shared_mutex> lock(state.mutex);
+			if (_Slot *slot = _Find(state, id)) {
+				std::string{}.swap(slot->name);
+				slot->generation++;
+				state.free.push_back(id.Index());
+			}
+		}
+
+		static std::string Resolve(TaskId id) {
+			_State &state = _GetState();
+			std::shared_lock<std::shared_mutex> lock(state.mutex);
+			if (_Slot *slot = _Find(state, id)) {
+				return slot->name;
+			}
+			return {};
+		}
+	};
+} // namespace Framework::Task
+
+template <>
+struct std::hash<Framework::Task::TaskId> {
+	std::size_t operator()(const Framework::Task::TaskId &id) const noexcept {
+		return std::hash<uint64_t>{}(id.Value());
+	}
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <type_traits>
 
 #include "Task/TaskBase.hpp"
 #include "Task/EventRequest.hpp"
@@ -8,7 +9,7 @@
 #include "Exception/Exception.hpp"
 
 namespace Framework::Task {
-	template <typename T = EventRequest<>::Command>
+	template <typename T = EventRequest<>::Command, typename R = EventRequest<T>>
 	class IEventTask {
 	public:
 		static constexpr auto WAIT_FOREVER = std::chrono::milliseconds::zero();
@@ -18,10 +19,16 @@ namespace Framework::Task {
 		virtual void Start() = 0;
 		virtual void Stop() = 0;
 
-		virtual void SendEvent(EventRequest<T> &&message) = 0;
-		virtual void SendEvent(const EventRequest<T> &message) = 0;
-
-		virtual bool RpcEvent(EventRequest<T> &&message, std::chrono::milliseconds timeoutMsec = WAIT_FOREVER) = 0;
-		virtual bool RpcEvent(const EventRequest<T> &message, std::chrono::milliseconds timeoutMsec = WAIT_FOREVER) = 0;
+		virtual void SendEvent(R &&message) = 0;
+		// Sends a copy; move-only requests must be passed as rvalues.
+		void SendEvent(const R &message) requires std::is_copy_constructible_v<R> {
+			SendEvent(R(message));
+		}
+
+		virtual bool RpcEvent(R &&message, std::chrono::milliseconds timeoutMsec = WAIT_FOREVER) = 0;
+		bool RpcEvent(const R &message, std::chrono::milliseconds timeoutMsec = WAIT_FOREVER)
+			requires std::is_copy_constructible_v<R> {
+			return RpcEvent(R(message), timeoutMsec);
+		}
 	};
 } // namespace Framework::Task
@@ -0,0 +1,16 @@
+#pragma once
+
+namespace Framework::Templates {
+	// RTTI-free type identity: the address of a per-type tag object, usable in constant expressions.
+	using TypeId = const void *;
+
+	template <typename T>
+	struct TypeTag {
+		static constexpr char id{ 0 };
+	};
+
+	template <typename T>
+	constexpr TypeId TypeIdOf() {
+		return &TypeTag<T>::id;
+	}
+} // namespace Framework::Templates
@@ -0,0 +1,125 @@
+#include "Message/Posix.hpp"
+
+#include <fcntl.h>
+#include <mqueue.h>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+
+#include "Exception/Exception.hpp"
+#include "Main/Config.hpp"
+
+namespace Framework::Message::Posix {
+	namespace {
+		[[noreturn]] void _ThrowSystemError(const std::string &operation, const std::string &path) {
+			throw Exception(operation + " " + path + ": " + std::strerror(errno), Error::Code::SystemError);
+		}
+
+		timespec _Deadline(std::chrono::milliseconds timeout) {
+			timespec deadline{};
+			clock_gettime(CLOCK_REALTIME, &deadline);
+			auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+			deadline.tv_sec += static_cast<time_t>(seconds.count());
+			deadline.tv_nsec += static_cast<long>(
+				std::chrono::duration_cast<std::chrono::nanoseconds>(timeout - seconds).count());
+			if (deadline.tv_nsec >= 1'000'000'000L) {
+				deadline.tv_sec++;
+				deadline.tv_nsec -= 1'000'000'000L;
+			}
+			return deadline;
+		}
+
+		// A deadline in the past makes the timed calls return at once instead of blocking.
+		constexpr timespec NO_WAIT{};
+	}
+
+	std::string Channel::Path(const std::string &name) {
+		return "/" + std::string(Configuration::Name::ROOT) + "." + name;
+	}
+
+	Channel::Channel(const std::string &name, std::size_t capacity, std::size_t messageSize) :
+		_path(Path(name)), _messageSize(messageSize) {
+		mq_attr attributes{};
+		attributes.mq_maxmsg = static_cast<long>(capacity);
+		attributes.mq_msgsize = static_cast<long>(messageSize);
+		_descriptor = mq_open(_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600, &attributes);
+		if (_descriptor == -1) {
+			_ThrowSystemError("mq_open", _path);
+		}
+		if (mq_getattr(_descriptor, &attributes) == -1 || attributes.mq_msgsize != static_cast<long>(messageSize)) {
+			mq_close(_descriptor);
+			throw Exception("Message queue " + _path + " exists with another message size", Error::Code::InvalidArgument);
+		}
+	}
+
+	Channel::~Channel() {
+		mq_close(_descriptor);
+	}
+
+	void Channel::Send(const void *message) {
+		while (mq_send(_descriptor, static_cast<const char *>(message), _messageSize, 0) == -1) {
+			if (errno != EINTR) {
+				_ThrowSystemError("mq_send", _path);
+			}
+		}
+	}
+
+	bool Channel::TrySend(const void *message) {
+		while (mq_timedsend(_descriptor, static_cast<const char *>(message), _messageSize, 0, &NO_WAIT) == -1) {
+			if (errno == ETIMEDOUT) {
+				return false;
+			}
+			if (errno != EINTR) {
+				_ThrowSystemError("mq_timedsend", _path);
+			}
+		}
+		return true;
+	}
+
+	void Channel::Receive(void *message) {
+		while (mq_receive(_descriptor, static_cast<char *>(message), _messageSize, nullptr) == -1) {
+			if (errno != EINTR) {
+				_ThrowSystemError("mq_receive", _path);
+			}
+		}
+	}
+
+	bool Channel::TryReceive(void *message) {
+		while (mq_timedreceive(_descriptor, static_cast<char *>(message), _messageSize, nullptr, &NO_WAIT) == -1) {
+			if (errno == ETIMEDOUT) {
+				return false;
+			}
+			if (errno != EINTR) {
+				_ThrowSystemError("mq_timedreceive", _path);
+			}
+		}
+		return true;
+	}
+
+	bool Channel::TimedReceive(void *message, std::chrono::milliseconds timeout) {
+		const timespec deadline = _Deadline(timeout);
+		while (mq_timedreceive(_descriptor, static_cast<char *>(message), _messageSize, nullptr, &deadline) == -1) {
+			if (errno == ETIMEDOUT) {
+				return false;
+			}
+			if (errno != EINTR) {
+				_ThrowSystemError("mq_timedreceive", _path);
+			}
+		}
+		return true;
+	}
+
+	std::size_t Channel::Count() {
+		mq_attr attributes{};
+		if (mq_getattr(_descriptor, &attributes) == -1) {
+			_ThrowSystemError("mq_getattr", _path);
+		}
+		return static_cast<std::size_t>(attributes.mq_curmsgs);
+	}
+
+	void Channel::Unlink() {
+		if (mq_unlink(_path.c_str()) == -1 && errno != ENOENT) {
+			_ThrowSystemError("mq_unlink", _path);
+		}
+	}
+} // namespace Framework::Message::Posix
@@ -0,0 +1,97 @@
+#include "Message/SharedMemory.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "Exception/Exception.hpp"
+#include "Main/Config.hpp"
+
+namespace Framework::Message {
+	namespace {
+		// How long an opener waits for the creator to size a region it has just created.
+		constexpr auto CREATION_TIMEOUT = std::chrono::seconds(1);
+
+		[[noreturn]] void _ThrowSystemError(const std::string &operation, const std::string &path) {
+			throw Exception(operation + " " + path + ": " + std::strerror(errno), Error::Code::SystemError);
+		}
+
+		std::size_t _WaitForSize(int descriptor, const std::string &path) {
+			const auto deadline = std::chrono::steady_clock::now() + CREATION_TIMEOUT;
+			struct stat status{};
+			while (true) {
+				if (fstat(descriptor, &status) == -1) {
+					_ThrowSystemError("fstat", path);
+				}
+				if (status.st_size != 0) {
+					return static_cast<std::size_t>(status.st_size);
+				}
+				if (std::chrono::steady_clock::now() >= deadline) {
+					throw Exception("Shared memory " + path + " was never sized", Error::Code::Timeout);
+				}
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	std::string SharedMemory::Path(const std::string &name) {
+		std::string path = (Configuration::Address::Root() / name).string();
+		std::replace(path.begin() + 1, path.end(), '/', '.');
+		return path;
+	}
+
+	SharedMemory::SharedMemory(const std::string &name, std::size_t size) :
+		_path(Path(name)), _size(size) {
+		int descriptor = shm_open(_path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+		if (descriptor != -1) {
+			_created = true;
+			if (ftruncate(descriptor, static_cast<off_t>(size)) == -1) {
+				close(descriptor);
+				shm_unlink(_path.c_str());
+				_ThrowSystemError("ftruncate", _path);
+			}
+		} else if (errno == EEXIST) {
+			descriptor = shm_open(_path.c_str(), O_RDWR | O_CLOEXEC, 0600);
+			if (descriptor == -1) {
+				_ThrowSystemError("shm_open", _path);
+			}
+			std::size_t existing;
+			try {
+				existing = _WaitForSize(descriptor, _path);
+			} catch (...) {
+				close(descriptor);
+				throw;
+			}
+			if (existing != size) {
+				close(descriptor);
+				throw Exception("Shared memory " + _path + " exists with another size", Error::Code::InvalidArgument);
+			}
+		} else {
+			_ThrowSystemError("shm_open", _path);
+		}
+		_address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+		close(descriptor);
+		if (_address == MAP_FAILED) {
+			_address = nullptr;
+			_ThrowSystemError("mmap", _path);
+		}
+	}
+
+	SharedMemory::~SharedMemory() {
+		if (_address) {
+			munmap(_address, _size);
+		}
+	}
+
+	void SharedMemory::Unlink() {
+		if (shm_unlink(_path.c_str()) == -1 && errno != ENOENT) {
+			_ThrowSystemError("shm_unlink", _path);
+		}
+	}
+} // namespace Framework::Message
@@ -0,0 +1,147 @@
+#include "Message/SystemV.hpp"
+
+#include <sys/ipc.h>
+#include <sys/msg.h>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#include "Exception/Exception.hpp"
+#include "Main/Config.hpp"
+
+namespace Framework::Message::SystemV {
+	namespace {
+		constexpr long MESSAGE_TYPE = 1;
+		constexpr int PROJECT_ID = 'M';
+		constexpr auto POLL_INTERVAL = std::chrono::milliseconds(1);
+
+		[[noreturn]] void _ThrowSystemError(const std::string &operation, int id) {
+			throw Exception(operation + " " + std::to_string(id) + ": " + std::strerror(errno), Error::Code::SystemError);
+		}
+	}
+
+	std::string Channel::Path(const std::string &name) {
+		return (Configuration::Address::Root() / name).string();
+	}
+
+	Channel::Channel(const std::string &name, std::size_t capacity, std::size_t messageSize) :
+		_path(Path(name)), _messageSize(messageSize) {
+		std::error_code error;
+		std::filesystem::create_directories(Configuration::Address::Root(), error);
+		std::ofstream(_path, std::ios::app);
+		key_t key = ftok(_path.c_str(), PROJECT_ID);
+		if (key == -1) {
+			throw Exception("ftok " + _path + ": " + std::strerror(errno), Error::Code::SystemError);
+		}
+		_id = msgget(key, IPC_CREAT | IPC_EXCL | 0600);
+		if (_id != -1) {
+			_Resize(capacity);
+			return;
+		}
+		if (errno != EEXIST || (_id = msgget(key, 0600)) == -1) {
+			throw Exception("msgget " + _path + ": " + std::strerror(errno), Error::Code::SystemError);
+		}
+		msqid_ds state{};
+		if (msgctl(_id, IPC_STAT, &state) == -1) {
+			_ThrowSystemError("msgctl", _id);
+		}
+		if (state.msg_qbytes < messageSize) {
+			throw Exception("System V queue " + _path + " cannot hold a message", Error::Code::InvalidArgument);
+		}
+	}
+
+	// Only the creating process sizes the queue; a failed resize removes the queue again. Growing past
+	// the system default (MSGMNB) needs CAP_SYS_RESOURCE, so without it the queue keeps the default size
+	// as long as that holds a message.
+	void Channel::_Resize(std::size_t capacity) {
+		msqid_ds state{};
+		if (msgctl(_id, IPC_STAT, &state) == -1) {
+			_ThrowSystemError("msgctl", _id);
+		}
+		// The kernel limits the queue in bytes; every message holds exactly messageSize of them.
+		const auto current = state.msg_qbytes;
+		state.msg_qbytes = static_cast<msglen_t>(capacity * _messageSize);
+		if (state.msg_qbytes == current || msgctl(_id, IPC_SET, &state) != -1) {
+			return;
+		}
+		if (errno == EPERM && state.msg_qbytes > current && current >= _messageSize) {
+			return;
+		}
+		const int resizeError = errno;
+		msgctl(_id, IPC_RMID, nullptr);
+		errno = resizeError;
+		_ThrowSystemError("msgctl", _id);
+	}
+
+	void Channel::Send(void *message) {
+		std::memcpy(message, &MESSAGE_TYPE, sizeof(MESSAGE_TYPE));
+		while (msgsnd(_id, message, _messageSize, 0) == -1) {
+			if (errno != EINTR) {
+				_ThrowSystemError("msgsnd", _id);
+			}
+		}
+	}
+
+	bool Channel::TrySend(void *message) {
+		std::memcpy(message, &MESSAGE_TYPE, sizeof(MESSAGE_TYPE));
+		while (msgsnd(_id, message, _messageSize, IPC_NOWAIT) == -1) {
+			if (errno == EAGAIN) {
+				return false;
+			}
+			if (errno != EINTR) {
+				_ThrowSystemError("msgsnd", _id);
+			}
+		}
+		return true;
+	}
+
+	void Channel::Receive(void *message) {
+		while (msgrcv(_id, message, _messageSize, 0, 0) == -1) {
+			if (errno != EINTR) {
+				_ThrowSystemError("msgrcv", _id);
+			}
+		}
+	}
+
+	bool Channel::TryReceive(void *message) {
+		while (msgrcv(_id, message, _messageSize, 0, IPC_NOWAIT) == -1) {
+			if (errno == ENOMSG) {
+				return false;
+			}
+			if (errno != EINTR) {
+				_ThrowSystemError("msgrcv", _id);
+			}
+		}
+		return true;
+	}
+
+	bool Channel::TimedReceive(void *message, std::chrono::milliseconds timeout) {
+		const auto deadline = std::chrono::steady_clock::now() + timeout;
+		while (!TryReceive(message)) {
+			const auto now = std::chrono::steady_clock::now();
+			if (now >= deadline) {
+				return false;
+			}
+			std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(POLL_INTERVAL, deadline - now));
+		}
+		return true;
+	}
+
+	std::size_t Channel::Count() {
+		msqid_ds state{};
+		if (msgctl(_id, IPC_STAT, &state) == -1) {
+			_ThrowSystemError("msgctl", _id);
+		}
+		return static_cast<std::size_t>(state.msg_qnum);
+	}
+
+	void Channel::Unlink() {
+		if (msgctl(_id, IPC_RMID, nullptr) == -1 && errno != EINVAL && errno != EIDRM) {
+			_ThrowSystemError("msgctl", _id);
+		}
+		std::error_code error;
+		std::filesystem::remove(_path, error);
+	}
+} // namespace Framework::Message::SystemV
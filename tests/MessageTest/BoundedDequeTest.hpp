@@ -0,0 +1,90 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <vector>
+#include "Message/BoundedDeque.hpp"
+
+using namespace Framework::Message;
+
+class BoundedDequeTest : public ::testing::Test {};
+
+TEST_F(BoundedDequeTest, BlockUntilReceived) {
+	BoundedDeque<int> queue{ 2 };
+	queue.Send(1);
+	queue.Send(2);
+	std::atomic<bool> sending{ false };
+	std::atomic<bool> sent{ false };
+	std::thread producer([&] {
+		sending = true;
+		queue.Send(3);
+		sent = true;
+	});
+	while (!sending) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	// Only a broken queue lets the send through, so a slow producer cannot fail this check.
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	EXPECT_FALSE(sent);
+	EXPECT_EQ(1, queue.Receive());
+	producer.join();
+	EXPECT_TRUE(sent);
+	EXPECT_EQ(2, queue.NumMessages());
+}
+
+TEST_F(BoundedDequeTest, Fail) {
+	BoundedDeque<int> queue{ 2, OverflowPolicy::FAIL };
+	EXPECT_TRUE(queue.TrySend(1));
+	EXPECT_TRUE(queue.TrySend(2));
+	EXPECT_FALSE(queue.TrySend(3));
+	try {
+		queue.Send(3);
+		FAIL();
+	} catch (const Framework::Exception &e) {
+		EXPECT_EQ(Framework::Error::Code::Overflow, e.GetCode());
+	}
+	EXPECT_EQ(1, queue.Receive());
+	EXPECT_TRUE(queue.TrySend(3));
+}
+
+TEST_F(BoundedDequeTest, DropOldest) {
+	std::vector<int> discarded;
+	BoundedDeque<int>::Handlers handlers;
+	handlers.discard = [&](int &&message) { discarded.push_back(message); };
+	BoundedDeque<int> queue{ 2, OverflowPolicy::DROP_OLDEST, handlers };
+	for (int i = 1; i <= 4; i++) {
+		queue.Send(i);
+	}
+	EXPECT_EQ(std::vector<int>({ 1, 2 }), discarded);
+	EXPECT_EQ(2u, queue.CountDiscarded());
+	EXPECT_EQ(3, queue.Receive());
+	EXPECT_EQ(4, queue.Receive());
+}
+
+TEST_F(BoundedDequeTest, Coalesce) {
+	BoundedDeque<int>::Handlers handlers;
+	handlers.coalesce = [](const int &queued, const int &message) { return queued / 10 == message / 10; };
+	BoundedDeque<int> queue{ 2, OverflowPolicy::COALESCE, handlers };
+	queue.Send(10);
+	queue.Send(20);
+	queue.Send(11);
+	queue.Send(12);
+	EXPECT_EQ(2, queue.NumMessages());
+	EXPECT_EQ(12, queue.Receive());
+	EXPECT_EQ(20, queue.Receive());
+}
+
+TEST_F(BoundedDequeTest, ExemptBypassesCapacity) {
+	BoundedDeque<int>::Handlers handlers;
+	handlers.exempt = [](const int &message) { return message < 0; };
+	BoundedDeque<int> queue{ 1, OverflowPolicy::FAIL, handlers };
+	EXPECT_TRUE(queue.TrySend(1));
+	EXPECT_TRUE(queue.TrySend(-1));
+	EXPECT_TRUE(queue.TrySend(-2));
+	EXPECT_FALSE(queue.TrySend(2));
+	std::deque<int> messages;
+	EXPECT_EQ(3u, queue.ReceiveBatch(messages, 8));
+	EXPECT_TRUE(queue.TrySend(2));
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include "Message/MessageQueueFactory.hpp"
+
+using namespace Framework::Message;
+
+namespace ChannelQueueUnitTest {
+	struct Sample {
+		int id;
+		double value;
+		char text[16];
+	};
+
+	constexpr std::size_t SAMPLE_SIZE = 64;
+}
+
+template <typename Queue>
+class ChannelQueueTest : public ::testing::Test {
+protected:
+	const std::string name = "ChannelQueueTest" + std::to_string(getpid());
+	std::unique_ptr<Queue> queue{ std::make_unique<Queue>(name, 4) };
+
+	void TearDown() override {
+		queue->Unlink();
+	}
+};
+
+using ChannelQueueTypes = ::testing::Types<
+	PosixQueue<ChannelQueueUnitTest::Sample, ChannelQueueUnitTest::SAMPLE_SIZE>,
+	SystemVQueue<ChannelQueueUnitTest::Sample, ChannelQueueUnitTest::SAMPLE_SIZE>>;
+TYPED_TEST_SUITE(ChannelQueueTest, ChannelQueueTypes);
+
+TYPED_TEST(ChannelQueueTest, SendAndReceive) {
+	ChannelQueueUnitTest::Sample sample{ 7, 1.5, "seven" };
+	this->queue->Send(sample);
+	EXPECT_EQ(1u, this->queue->NumMessages());
+	auto received = this->queue->Receive();
+	EXPECT_EQ(7, received.id);
+	EXPECT_EQ(1.5, received.value);
+	EXPECT_STREQ("seven", received.text);
+	EXPECT_TRUE(this->queue->IsEmpty());
+}
+
+TYPED_TEST(ChannelQueueTest, FullAndEmpty) {
+	EXPECT_FALSE(this->queue->TryReceive().first);
+	for (int i = 0; i < 4; i++) {
+		EXPECT_TRUE(this->queue->TrySend({ i, 0, "" }));
+	}
+	EXPECT_FALSE(this->queue->TrySend({ 4, 0, "" }));
+	EXPECT_EQ(0, this->queue->TryReceive().second.id);
+	this->queue->Clear();
+	EXPECT_TRUE(this->queue->IsEmpty());
+	EXPECT_FALSE(this->queue->TimedReceive(std::chrono::milliseconds(20)).first);
+}
+
+TYPED_TEST(ChannelQueueTest, ReceiveBatch) {
+	for (int i = 0; i < 3; i++) {
+		this->queue->Send({ i, 0, "" });
+	}
+	std::deque<ChannelQueueUnitTest::Sample> batch;
+	EXPECT_EQ(2u, this->queue->ReceiveBatch(batch, 2));
+	EXPECT_EQ(1u, this->queue->ReceiveBatch(batch, 8, std::chrono::milliseconds(20)));
+	EXPECT_EQ(0u, this->queue->ReceiveBatch(batch, 8, std::chrono::milliseconds(20)));
+	ASSERT_EQ(3u, batch.size());
+	EXPECT_EQ(2, batch.back().id);
+}
+
+TYPED_TEST(ChannelQueueTest, AcrossProcesses) {
+	constexpr int COUNT = 16;
+	pid_t child = fork();
+	ASSERT_NE(-1, child);
+	if (child == 0) {
+		TypeParam producer{ this->name, 4 };
+		for (int i = 0; i < COUNT; i++) {
+			producer.Send({ i, i * 0.5, "child" });
+		}
+		_exit(0);
+	}
+	for (int i = 0; i < COUNT; i++) {
+		auto received = this->queue->Receive();
+		EXPECT_EQ(i, received.id);
+		EXPECT_STREQ("child", received.text);
+	}
+	int status = 0;
+	waitpid(child, &status, 0);
+	EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
+
+TEST(ChannelQueueFactoryTest, Create) {
+	const std::string name = "ChannelQueueFactoryTest" + std::to_string(getpid());
+	for (auto type : { MessageQueueFactory::Type::POSIX_MQUEUE, MessageQueueFactory::Type::SYSTEM_V }) {
+		std::unique_ptr<IMessageQueue<int>> sender{ MessageQueueFactory::Create<int>(type, name) };
+		std::unique_ptr<IMessageQueue<int>> receiver{ MessageQueueFactory::Create<int>(type, name) };
+		sender->Send(42);
+		EXPECT_EQ(42, receiver->Receive());
+		if (type == MessageQueueFactory::Type::POSIX_MQUEUE) {
+			static_cast<PosixQueue<int> &>(*sender).Unlink();
+		} else {
+			static_cast<SystemVQueue<int> &>(*sender).Unlink();
+		}
+	}
+	EXPECT_THROW(MessageQueueFactory::Create<int>(MessageQueueFactory::Type::SYSTEM_V), Framework::Exception);
+}
+
+TEST(SystemVChannelTest, OpenerKeepsCapacity) {
+	const std::string name = "SystemVChannelTest" + std::to_string(getpid());
+	SystemVQueue<int> creator{ name, 2 };
+	SystemVQueue<int> opener{ name, 8 };
+	EXPECT_TRUE(std::filesystem::exists(SystemV::Channel::Path(name)));
+	EXPECT_TRUE(opener.TrySend(1));
+	EXPECT_TRUE(opener.TrySend(2));
+	EXPECT_FALSE(opener.TrySend(3));
+	EXPECT_EQ(1, creator.Receive());
+	creator.Unlink();
+	EXPECT_FALSE(std::filesystem::exists(SystemV::Channel::Path(name)));
+}
+
+TEST(SystemVChannelTest, CapacityBeyondSystemDefault) {
+	// 512 messages of SAMPLE_SIZE bytes exceed the 16384 byte default an unprivileged process is held to.
+	constexpr std::size_t CAPACITY = 512;
+	const std::string name = "SystemVChannelTest" + std::to_string(getpid());
+	SystemVQueue<ChannelQueueUnitTest::Sample, ChannelQueueUnitTest::SAMPLE_SIZE> queue{ name, CAPACITY };
+	std::size_t sent = 0;
+	while (sent <= CAPACITY && queue.TrySend({ static_cast<int>(sent), 0, "" })) {
+		sent++;
+	}
+	// Either the full capacity or, without the privilege to grow the queue, what the default holds.
+	EXPECT_GE(sent, std::min(CAPACITY, 16384 / ChannelQueueUnitTest::SAMPLE_SIZE));
+	EXPECT_LE(sent, CAPACITY);
+	EXPECT_EQ(0, queue.Receive().id);
+	queue.Unlink();
+}
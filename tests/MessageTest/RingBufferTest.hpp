@@ -0,0 +1,104 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include "Message/RingBuffer.hpp"
+
+using namespace Framework::Message;
+
+class RingBufferTest : public ::testing::Test {
+protected:
+	RingBuffer<int> queue{ 8 };
+};
+
+TEST_F(RingBufferTest, Capacity) {
+	EXPECT_EQ(8, queue.Capacity());
+	RingBuffer<int> rounded{ 5 };
+	EXPECT_EQ(8, rounded.Capacity());
+}
+
+TEST_F(RingBufferTest, SendAndReceiveMultiple) {
+	queue.Send(1);
+	queue.Send(2);
+	queue.Send(3);
+	EXPECT_EQ(1, queue.Receive());
+	EXPECT_EQ(2, queue.Receive());
+	EXPECT_EQ(3, queue.Receive());
+}
+
+TEST_F(RingBufferTest, TimedReceiveSuccess) {
+	queue.Send(42);
+	auto result = queue.TimedReceive(std::chrono::milliseconds(100));
+	EXPECT_TRUE(result.first);
+	EXPECT_EQ(42, result.second);
+}
+
+TEST_F(RingBufferTest, TryReceive) {
+	EXPECT_FALSE(queue.TryReceive().first);
+	queue.Send(42);
+	auto result = queue.TryReceive();
+	EXPECT_TRUE(result.first);
+	EXPECT_EQ(42, result.second);
+	EXPECT_FALSE(queue.TryReceive().first);
+}
+
+TEST_F(RingBufferTest, TimedReceiveTimeout) {
+	auto result = queue.TimedReceive(std::chrono::milliseconds(100));
+	EXPECT_FALSE(result.first);
+}
+
+TEST_F(RingBufferTest, ClearAndNumMessages) {
+	EXPECT_TRUE(queue.IsEmpty());
+	queue.Send(1);
+	queue.Send(2);
+	EXPECT_EQ(2, queue.NumMessages());
+	queue.Clear();
+	EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST_F(RingBufferTest, WakeUpParkedConsumer) {
+	std::thread sender([&]() {
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		queue.Send(7);
+	});
+	EXPECT_EQ(7, queue.Receive());
+	sender.join();
+}
+
+TEST_F(RingBufferTest, MultipleProducersBlockWhenFull) {
+	constexpr int numProducers = 4;
+	constexpr int numMessages = 1000;
+	std::vector<std::thread> producers;
+	for (int p = 0; p < numProducers; p++) {
+		producers.emplace_back([&, p]() {
+			for (int i = 0; i < numMessages; i++) {
+				queue.Send(p * numMessages + i);
+			}
+		});
+	}
+
+	std::vector<int> lastReceived(numProducers, -1);
+	for (int i = 0; i < numProducers * numMessages; i++) {
+		int value = queue.Receive();
+		int producer = value / numMessages;
+		EXPECT_LT(lastReceived[producer], value % numMessages);
+		lastReceived[producer] = value % numMessages;
+	}
+	for (auto &producer : producers) {
+		producer.join();
+	}
+	EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST_F(RingBufferTest, ReceiveBatch) {
+	queue.Send(1);
+	queue.Send(2);
+	queue.Send(3);
+	std::deque<int> messages;
+	EXPECT_EQ(2, queue.ReceiveBatch(messages, 2));
+	EXPECT_EQ(1, queue.ReceiveBatch(messages, 2));
+	EXPECT_EQ(std::deque<int>({ 1, 2, 3 }), messages);
+	EXPECT_EQ(0, queue.ReceiveBatch(messages, 2, std::chrono::milliseconds(100)));
+}
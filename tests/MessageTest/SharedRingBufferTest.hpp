@@ -0,0 +1,98 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <string>
+#include "Message/MessageQueueFactory.hpp"
+
+using namespace Framework::Message;
+
+namespace SharedRingBufferUnitTest {
+	struct Event {
+		int producer;
+		int sequence;
+	};
+}
+
+class SharedRingBufferTest : public ::testing::Test {
+protected:
+	using Event = SharedRingBufferUnitTest::Event;
+
+	const std::string name = "SharedRingBufferTest" + std::to_string(getpid());
+	SharedRingBuffer<Event, 32> queue{ name, 8 };
+
+	void TearDown() override {
+		queue.Unlink();
+	}
+};
+
+TEST_F(SharedRingBufferTest, SharedBetweenMappings) {
+	SharedRingBuffer<Event, 32> producer{ name, 8 };
+	EXPECT_EQ(8u, producer.Capacity());
+	producer.Send({ 1, 2 });
+	EXPECT_EQ(1u, queue.NumMessages());
+	auto event = queue.Receive();
+	EXPECT_EQ(1, event.producer);
+	EXPECT_EQ(2, event.sequence);
+	EXPECT_TRUE(producer.IsEmpty());
+}
+
+TEST_F(SharedRingBufferTest, FullAndEmpty) {
+	EXPECT_FALSE(queue.TryReceive().first);
+	EXPECT_FALSE(queue.TimedReceive(std::chrono::milliseconds(10)).first);
+	for (int i = 0; i < 8; i++) {
+		EXPECT_TRUE(queue.TrySend({ 0, i }));
+	}
+	EXPECT_FALSE(queue.TrySend({ 0, 8 }));
+	std::deque<Event> batch;
+	EXPECT_EQ(8u, queue.ReceiveBatch(batch, 16));
+	EXPECT_EQ(7, batch.back().sequence);
+}
+
+TEST_F(SharedRingBufferTest, LayoutMismatch) {
+	EXPECT_THROW((SharedRingBuffer<Event, 32>{ name, 16 }), Framework::Exception);
+}
+
+TEST_F(SharedRingBufferTest, ProducerProcesses) {
+	constexpr int PRODUCERS = 2;
+	constexpr int EVENTS = 20000;
+	std::array<pid_t, PRODUCERS> children{};
+	for (int producer = 0; producer < PRODUCERS; producer++) {
+		children[producer] = fork();
+		ASSERT_NE(-1, children[producer]);
+		if (children[producer] == 0) {
+			SharedRingBuffer<Event, 32> sender{ name, 8 };
+			for (int i = 0; i < EVENTS; i++) {
+				sender.Send({ producer, i });
+			}
+			_exit(0);
+		}
+	}
+	std::array<int, PRODUCERS> next{};
+	bool ordered = true;
+	for (int i = 0; i < PRODUCERS * EVENTS; i++) {
+		auto event = queue.Receive();
+		ordered = ordered && event.sequence == next[event.producer]++;
+	}
+	EXPECT_TRUE(ordered);
+	EXPECT_TRUE(queue.IsEmpty());
+	for (pid_t child : children) {
+		int status = 0;
+		waitpid(child, &status, 0);
+		EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+	}
+}
+
+TEST(SharedRingBufferFactoryTest, Create) {
+	const std::string name = "SharedRingBufferFactoryTest" + std::to_string(getpid());
+	using Type = MessageQueueFactory::Type;
+	std::unique_ptr<IMessageQueue<int>> sender{ MessageQueueFactory::Create<int>(Type::SHARED_RING_BUFFER, name) };
+	std::unique_ptr<IMessageQueue<int>> receiver{ MessageQueueFactory::Create<int>(Type::SHARED_RING_BUFFER, name) };
+	sender->Send(42);
+	EXPECT_EQ(42, receiver->Receive());
+	static_cast<SharedRingBuffer<int> &>(*sender).Unlink();
+}
@@ -33,6 +33,15 @@ TEST_F(SynchronizedDequeTest, TimedReceiveSuccess) {
 	EXPECT_EQ(42, result.second);
 }
 
+TEST_F(SynchronizedDequeTest, TryReceive) {
+	EXPECT_FALSE(queue.TryReceive().first);
+	queue.Send(42);
+	auto result = queue.TryReceive();
+	EXPECT_TRUE(result.first);
+	EXPECT_EQ(42, result.second);
+	EXPECT_FALSE(queue.TryReceive().first);
+}
+
 TEST_F(SynchronizedDequeTest, TimedReceiveTimeout) {
 	auto result = queue.TimedReceive(std::chrono::milliseconds(100));
 	EXPECT_FALSE(result.first);
@@ -78,3 +87,29 @@ TEST_F(SynchronizedDequeTest, ConcurrentSendAndReceive) {
 	sender.join();
 	receiver.join();
 }
+
+TEST_F(SynchronizedDequeTest, ReceiveBatchAll) {
+	queue.Send(1);
+	queue.Send(2);
+	queue.Send(3);
+	std::deque<int> messages;
+	EXPECT_EQ(3, queue.ReceiveBatch(messages, 10));
+	EXPECT_EQ(std::deque<int>({ 1, 2, 3 }), messages);
+	EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST_F(SynchronizedDequeTest, ReceiveBatchLimited) {
+	queue.Send(1);
+	queue.Send(2);
+	queue.Send(3);
+	std::deque<int> messages;
+	EXPECT_EQ(2, queue.ReceiveBatch(messages, 2));
+	EXPECT_EQ(std::deque<int>({ 1, 2 }), messages);
+	EXPECT_EQ(1, queue.NumMessages());
+}
+
+TEST_F(SynchronizedDequeTest, ReceiveBatchTimeout) {
+	std::deque<int> messages;
+	EXPECT_EQ(0, queue.ReceiveBatch(messages, 10, std::chrono::milliseconds(100)));
+	EXPECT_TRUE(messages.empty());
+}
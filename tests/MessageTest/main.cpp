@@ -1,2 +1,6 @@
 #include "gtest/gtest.h"
 #include "SynchronizedDequeTest.hpp"
+#include "RingBufferTest.hpp"
+#include "BoundedDequeTest.hpp"
+#include "ChannelQueueTest.hpp"
+#include "SharedRingBufferTest.hpp"
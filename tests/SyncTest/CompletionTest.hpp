@@ -0,0 +1,72 @@
+#pragma once
+
+#include <stdexcept>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "Sync/Completion.hpp"
+
+using namespace Framework::Sync;
+
+class CompletionTest : public ::testing::Test {
+protected:
+	CompletionPool<> pool;
+};
+
+TEST_F(CompletionTest, SetBeforeWait) {
+	Completion *completion = pool.Acquire();
+	completion->Set(true);
+	EXPECT_TRUE(completion->Wait());
+	EXPECT_TRUE(completion->GetResponse());
+}
+
+TEST_F(CompletionTest, SlotIsReused) {
+	Completion *first = pool.Acquire();
+	first->Set(false);
+	EXPECT_TRUE(first->Wait());
+	EXPECT_FALSE(first->GetResponse());
+	EXPECT_EQ(first, pool.Acquire());
+}
+
+TEST_F(CompletionTest, WaitFromAnotherThread) {
+	Completion *completion = pool.Acquire();
+	std::thread completer([completion] {
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		completion->Set(true);
+	});
+	EXPECT_TRUE(completion->Wait(std::chrono::milliseconds(1000)));
+	EXPECT_TRUE(completion->GetResponse());
+	completer.join();
+}
+
+TEST_F(CompletionTest, Exception) {
+	Completion *completion = pool.Acquire();
+	try {
+		throw std::runtime_error("handler");
+	} catch (...) {
+		completion->HandleException();
+	}
+	EXPECT_TRUE(completion->Wait());
+	EXPECT_THROW(completion->GetResponse(), std::runtime_error);
+}
+
+TEST_F(CompletionTest, TimeoutAbandonsSlot) {
+	Completion *abandoned = pool.Acquire();
+	EXPECT_FALSE(abandoned->Wait(std::chrono::milliseconds(50)));
+	Completion *next = pool.Acquire();
+	EXPECT_NE(abandoned, next);
+	next->Release();
+
+	abandoned->Set(true);
+	EXPECT_EQ(abandoned, pool.Acquire());
+}
+
+TEST_F(CompletionTest, OrphanedSlotIsFreedByCompleter) {
+	Completion *orphan = nullptr;
+	{
+		CompletionPool<> shortLived;
+		orphan = shortLived.Acquire();
+		EXPECT_FALSE(orphan->Wait(std::chrono::milliseconds(10)));
+	}
+	orphan->Set(true);
+}
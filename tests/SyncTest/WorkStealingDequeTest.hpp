@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Sync/WorkStealingDeque.hpp"
+
+class WorkStealingDequeTest : public ::testing::Test {};
+
+using Framework::Sync::WorkStealingDeque;
+
+TEST_F(WorkStealingDequeTest, OwnerIsLifo) {
+	WorkStealingDeque<int> deque{ 2 };
+	for (int i = 0; i < 10; i++) {
+		deque.Push(i);
+	}
+	EXPECT_EQ(10u, deque.Size());
+	EXPECT_EQ(9, deque.Take());
+	EXPECT_EQ(0, deque.Steal());
+	EXPECT_EQ(8u, deque.Size());
+}
+
+TEST_F(WorkStealingDequeTest, Empty) {
+	WorkStealingDeque<int> deque;
+	EXPECT_TRUE(deque.IsEmpty());
+	EXPECT_FALSE(deque.Take());
+	EXPECT_FALSE(deque.Steal());
+	deque.Push(1);
+	EXPECT_EQ(1, deque.Take());
+	EXPECT_FALSE(deque.Take());
+}
+
+TEST_F(WorkStealingDequeTest, ConcurrentSteal) {
+	constexpr int count = 100000;
+	WorkStealingDeque<int> deque{ 16 };
+	std::vector<std::atomic<int>> seen(count);
+	std::atomic<bool> done{ false };
+	std::vector<std::thread> thieves;
+	for (int i = 0; i < 3; i++) {
+		thieves.emplace_back([&] {
+			while (!done || !deque.IsEmpty()) {
+				if (auto value = deque.Steal()) {
+					seen[*value]++;
+				}
+			}
+		});
+	}
+	for (int i = 0; i < count; i++) {
+		deque.Push(i);
+		if (i % 3 == 0) {
+			if (auto value = deque.Take()) {
+				seen[*value]++;
+			}
+		}
+	}
+	done = true;
+	for (auto &thief : thieves) {
+		thief.join();
+	}
+	for (int i = 0; i < count; i++) {
+		EXPECT_EQ(1, seen[i].load()) << i;
+	}
+}
@@ -1,6 +1,8 @@
 #include "gtest/gtest.h"
 #include "Sync/EventFlag.hpp"
 #include <thread>
+#include "CompletionTest.hpp"
+#include "WorkStealingDequeTest.hpp"
 // NOLINTBEGIN
 class EventFlagTest :public::testing::Test {
 protected:
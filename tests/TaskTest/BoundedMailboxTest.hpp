@@ -0,0 +1,112 @@
+#pragma once
+
+#include <future>
+
+#include "gtest/gtest.h"
+#include "Task/MessageTask.hpp"
+#include "ParkedTask.hpp"
+
+class BoundedMailboxTest : public ::testing::Test {};
+
+using namespace Framework::Task;
+
+namespace BoundedMailboxUnitTest {
+	enum class MailboxCommands : int {
+		BLOCK = 0,
+		COUNT,
+		OTHER,
+	};
+	using MailboxTask = MessageTask<MailboxCommands>;
+	using Args = MessageEventArgs<MailboxCommands>;
+
+	struct Context {
+		std::shared_future<void> release;
+		std::atomic<int> counted{ 0 };
+		std::atomic<int> others{ 0 };
+	};
+	inline Context mailboxContext;
+
+	const MailboxTask::EventMap mailboxEvents{
+		{ MailboxCommands::BLOCK, { [](const Args &) {
+			mailboxContext.release.wait();
+			return true;
+		} } },
+		{ MailboxCommands::COUNT, { [](const Args &) {
+			mailboxContext.counted++;
+			return true;
+		} } },
+		{ MailboxCommands::OTHER, { [](const Args &) {
+			mailboxContext.others++;
+			return true;
+		} } },
+	};
+
+	inline std::promise<void> Park(MailboxTask &task) {
+		mailboxContext.counted = 0;
+		mailboxContext.others = 0;
+		return ParkedTask::Park(task, mailboxContext.release, MailboxCommands::BLOCK);
+	}
+}
+
+using namespace BoundedMailboxUnitTest;
+using ParkedTask::WaitForDepth;
+
+TEST_F(BoundedMailboxTest, Fail) {
+	MailboxTask task{ "BoundedMailboxTest", mailboxEvents,
+		{ MailboxTask::QueueType::BOUNDED_DEQUE, 2, MailboxTask::OverflowPolicy::FAIL } };
+	auto release = Park(task);
+	EXPECT_EQ(Framework::Error::Code::Success, task.TrySendEvent({ "Test", MailboxCommands::COUNT }));
+	EXPECT_EQ(Framework::Error::Code::Success, task.TrySendEvent({ "Test", MailboxCommands::COUNT }));
+	EXPECT_EQ(Framework::Error::Code::Overflow, task.TrySendEvent({ "Test", MailboxCommands::COUNT }));
+	EXPECT_THROW(task.SendEvent({ "Test", MailboxCommands::COUNT }), Framework::Exception);
+	release.set_value();
+	WaitForDepth(task, 0);
+	EXPECT_TRUE(task.RpcEvent({ "Test", MailboxCommands::COUNT }));
+	EXPECT_EQ(3, mailboxContext.counted);
+}
+
+TEST_F(BoundedMailboxTest, DropOldestFailsDroppedRpc) {
+	MailboxTask task{ "BoundedMailboxTest", mailboxEvents,
+		{ MailboxTask::QueueType::BOUNDED_DEQUE, 2, MailboxTask::OverflowPolicy::DROP_OLDEST } };
+	auto release = Park(task);
+	auto dropped = std::async(std::launch::async, [&task] {
+		return task.RpcEvent({ "Test", MailboxCommands::OTHER });
+	});
+	WaitForDepth(task, 1);
+	for (int i = 0; i < 3; i++) {
+		task.SendEvent({ "Test", MailboxCommands::COUNT });
+	}
+	try {
+		dropped.get();
+		FAIL();
+	} catch (const Framework::Exception &e) {
+		EXPECT_EQ(Framework::Error::Code::Overflow, e.GetCode());
+	}
+	EXPECT_EQ(2u, task.GetMailboxMetrics().discardedEvents);
+	release.set_value();
+	WaitForDepth(task, 0);
+	task.Stop();
+	EXPECT_EQ(2, mailboxContext.counted);
+	EXPECT_EQ(0, mailboxContext.others);
+}
+
+TEST_F(BoundedMailboxTest, CoalesceAndStop) {
+	MailboxTask task{ "BoundedMailboxTest", mailboxEvents,
+		{ MailboxTask::QueueType::BOUNDED_DEQUE, 2, MailboxTask::OverflowPolicy::COALESCE } };
+	auto release = Park(task);
+	task.SendEvent({ "Test", MailboxCommands::OTHER });
+	for (int i = 0; i < 5; i++) {
+		task.SendEvent({ "Test", MailboxCommands::COUNT });
+	}
+	EXPECT_EQ(2u, task.GetMailboxMetrics().currentDepth);
+	release.set_value();
+	WaitForDepth(task, 0);
+	task.Stop();
+	EXPECT_EQ(1, mailboxContext.counted);
+	EXPECT_EQ(1, mailboxContext.others);
+}
+
+TEST_F(BoundedMailboxTest, RingBufferOnlyBlocks) {
+	EXPECT_THROW((MailboxTask{ "BoundedMailboxTest", mailboxEvents,
+		{ MailboxTask::QueueType::RING_BUFFER, 8, MailboxTask::OverflowPolicy::FAIL } }), Framework::Exception);
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Task/MessageTask.hpp"
+#include "Eventually.hpp"
+#include "ParkedTask.hpp"
+
+class CoalescingTest : public ::testing::Test {};
+
+using namespace Framework::Task;
+
+namespace CoalescingUnitTest {
+	enum class CoalescingCommands : int {
+		BLOCK = 0,
+		REFRESH,
+		ADD,
+		LOG,
+	};
+	using CoalescingTask = MessageTask<CoalescingCommands>;
+	using Args = MessageEventArgs<CoalescingCommands>;
+	using Request = EventRequest<CoalescingCommands>;
+
+	struct Context {
+		std::shared_future<void> release;
+		std::vector<std::pair<CoalescingCommands, int>> handled;
+	};
+	inline Context coalescingContext;
+
+	const CoalescingTask::EventMap coalescingEvents{
+		{ CoalescingCommands::BLOCK, { [](const Args &) {
+			coalescingContext.release.wait();
+			return true;
+		} } },
+		{ CoalescingCommands::REFRESH, { [](const Args &args) {
+			coalescingContext.handled.emplace_back(CoalescingCommands::REFRESH, args.GetRequest().GetPayloadAs<int>());
+			return true;
+		} } },
+		{ CoalescingCommands::ADD, { [](const Args &args) {
+			coalescingContext.handled.emplace_back(CoalescingCommands::ADD, args.GetRequest().GetPayloadAs<int>());
+			return true;
+		} } },
+		{ CoalescingCommands::LOG, { [](const Args &args) {
+			coalescingContext.handled.emplace_back(CoalescingCommands::LOG, args.GetRequest().GetPayloadAs<int>());
+			return true;
+		} } },
+	};
+}
+
+using namespace CoalescingUnitTest;
+
+TEST_F(CoalescingTest, ReplaceAndMerge) {
+	CoalescingTask task{ "CoalescingTest", coalescingEvents };
+	task.SetCoalescing(CoalescingCommands::REFRESH);
+	task.SetCoalescing(CoalescingCommands::ADD, [](Request &pending, Request &&request) {
+		pending = Request{ request.GetFrom(), request.GetCommand(),
+			pending.GetPayloadAs<int>() + request.GetPayloadAs<int>() };
+	});
+	task.EnableMetrics();
+	coalescingContext.handled.clear();
+	auto release = ParkedTask::Park(task, coalescingContext.release, CoalescingCommands::BLOCK);
+
+	for (int i = 1; i <= 100; i++) {
+		task.SendEvent({ "Test", CoalescingCommands::REFRESH, i });
+		task.SendEvent({ "Test", CoalescingCommands::ADD, i });
+		if (i % 50 == 0) {
+			task.SendEvent({ "Test", CoalescingCommands::LOG, i });
+		}
+	}
+	release.set_value();
+	EXPECT_TRUE(task.RpcEvent({ "Test", CoalescingCommands::LOG, 0 }));
+
+	const std::vector<std::pair<CoalescingCommands, int>> expected{
+		{ CoalescingCommands::REFRESH, 100 },
+		{ CoalescingCommands::ADD, 5050 },
+		{ CoalescingCommands::LOG, 50 },
+		{ CoalescingCommands::LOG, 100 },
+		{ CoalescingCommands::LOG, 0 },
+	};
+	EXPECT_EQ(expected, coalescingContext.handled);
+	auto metrics = task.GetMailboxMetrics();
+	EXPECT_EQ(198u, metrics.coalescedEvents);
+	EXPECT_EQ(6u, metrics.processedEvents);
+
+	coalescingContext.handled.clear();
+	task.SendEvent({ "Test", CoalescingCommands::REFRESH, 7 });
+	EXPECT_TRUE(task.RpcEvent({ "Test", CoalescingCommands::REFRESH, 8 }));
+	const std::vector<std::pair<CoalescingCommands, int>> uncoalesced{
+		{ CoalescingCommands::REFRESH, 7 },
+		{ CoalescingCommands::REFRESH, 8 },
+	};
+	EXPECT_EQ(uncoalesced, coalescingContext.handled);
+}
+
+TEST_F(CoalescingTest, FullRingBuffer) {
+	CoalescingTask task{ "CoalescingTest", coalescingEvents,
+		{ CoalescingTask::QueueType::RING_BUFFER, 2, CoalescingTask::OverflowPolicy::BLOCK } };
+	task.SetCoalescing(CoalescingCommands::REFRESH);
+	task.SetCoalescing(CoalescingCommands::ADD, [](Request &pending, Request &&request) {
+		pending = Request{ request.GetFrom(), request.GetCommand(),
+			pending.GetPayloadAs<int>() + request.GetPayloadAs<int>() };
+	});
+	coalescingContext.handled.clear();
+	auto release = ParkedTask::Park(task, coalescingContext.release, CoalescingCommands::BLOCK);
+
+	task.SendEvent({ "Test", CoalescingCommands::ADD, 1 });
+	task.SendEvent({ "Test", CoalescingCommands::LOG, 0 });
+	std::atomic_bool sending = false;
+	std::thread sender([&task, &sending] {
+		sending = true;
+		task.SendEvent({ "Test", CoalescingCommands::REFRESH, 5 });
+	});
+	// The outcome is the same whether or not the sender has blocked on the full mailbox yet;
+	// waiting for it to start only makes the overlap likely.
+	EXPECT_TRUE(Eventually::Holds([&] { return sending.load(); }));
+	task.SendEvent({ "Test", CoalescingCommands::ADD, 2 });
+	release.set_value();
+	sender.join();
+	EXPECT_TRUE(task.RpcEvent({ "Test", CoalescingCommands::LOG, 1 }));
+
+	const std::vector<std::pair<CoalescingCommands, int>> expected{
+		{ CoalescingCommands::ADD, 3 },
+		{ CoalescingCommands::LOG, 0 },
+		{ CoalescingCommands::REFRESH, 5 },
+		{ CoalescingCommands::LOG, 1 },
+	};
+	EXPECT_EQ(expected, coalescingContext.handled);
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <mutex>
+
+#include "gtest/gtest.h"
+#include "Task/CpuTopology.hpp"
+#include "Task/TaskPool.hpp"
+
+class CpuTopologyTest : public ::testing::Test {};
+
+using namespace Framework::Task;
+
+TEST_F(CpuTopologyTest, ParseCpuList) {
+	EXPECT_EQ((std::vector<int>{ 0, 1, 2, 3, 8, 10, 11 }), CpuTopology::ParseCpuList("0-3,8,10-11\n"));
+	EXPECT_TRUE(CpuTopology::ParseCpuList("").empty());
+}
+
+TEST_F(CpuTopologyTest, GroupsByNode) {
+	CpuTopology topology{ { 0, 1, 2, 3 }, { { 0, 2 }, { 1, 3 } } };
+	EXPECT_EQ(2u, topology.CountNodes());
+	EXPECT_EQ((std::vector<int>{ 0, 2, 1, 3 }), topology.Cpus());
+	EXPECT_EQ(1, topology.NodeOf(3));
+	EXPECT_EQ((std::vector<int>{ 1, 3 }), topology.CpusOf(1));
+}
+
+TEST_F(CpuTopologyTest, Detect) {
+	auto root = std::filesystem::temp_directory_path() / "CpuTopologyTest";
+	std::filesystem::remove_all(root);
+	std::filesystem::create_directories(root / "node1");
+	std::filesystem::create_directories(root / "node0");
+	std::filesystem::create_directories(root / "power");
+	std::ofstream(root / "node0" / "cpulist") << "0-1023\n";
+	std::ofstream(root / "node1" / "cpulist") << "\n";
+	auto topology = CpuTopology::Detect(root.string());
+	EXPECT_EQ(2u, topology.CountNodes());
+	EXPECT_FALSE(topology.Cpus().empty());
+	for (int cpu : topology.Cpus()) {
+		EXPECT_EQ(0, topology.NodeOf(cpu));
+	}
+	std::filesystem::remove_all(root);
+}
+
+TEST_F(CpuTopologyTest, PinnedWorkers) {
+	TaskPool::Options options;
+	options.concurrency = 2;
+	options.pinWorkers = true;
+	TaskPool pool{ "Test", options };
+	auto cpus = CpuTopology::Detect().Cpus();
+	EXPECT_EQ(cpus[0], pool.GetPlacement(0).cpu);
+	EXPECT_EQ(cpus[1 % cpus.size()], pool.GetPlacement(1).cpu);
+
+	std::mutex mutex;
+	std::set<int> affinityCounts;
+	for (int i = 0; i < 20; i++) {
+		pool.Enqueue([&] {
+			cpu_set_t cpu_set;
+			CPU_ZERO(&cpu_set);
+			pthread_getaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+			std::lock_guard<std::mutex> lock(mutex);
+			affinityCounts.insert(CPU_COUNT(&cpu_set));
+		});
+	}
+	pool.Stop();
+	EXPECT_EQ((std::set<int>{ 1 }), affinityCounts);
+}
+
+TEST_F(CpuTopologyTest, NumaAwareStealing) {
+	TaskPool::Options options;
+	options.concurrency = 4;
+	options.scheduler = TaskPool::Scheduler::WORK_STEALING;
+	options.numaAware = true;
+	TaskPool pool{ "Test", options };
+	EXPECT_EQ(-1, pool.GetPlacement(0).cpu);
+	std::atomic_int counter = 0;
+	for (int i = 0; i < 100; i++) {
+		pool.Enqueue([&] { counter++; });
+	}
+	pool.Stop();
+	EXPECT_EQ(100, counter);
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+
+#include "gtest/gtest.h"
+#include "Task/TaskPool.hpp"
+#include "Eventually.hpp"
+
+class ElasticTaskPoolTest : public ::testing::Test {};
+
+using namespace Framework::Task;
+
+namespace ElasticTaskPoolUnitTest {
+	TaskPool::Options ElasticOptions() {
+		TaskPool::Options options;
+		options.concurrency = 1;
+		options.maxConcurrency = 4;
+		options.idleTimeout = std::chrono::milliseconds(100);
+		return options;
+	}
+}
+
+TEST_F(ElasticTaskPoolTest, GrowsAndRetires) {
+	TaskPool pool{ "Test", ElasticTaskPoolUnitTest::ElasticOptions() };
+	EXPECT_EQ(1u, pool.CountWorkers());
+	EXPECT_EQ(4u, pool.MaxConcurrency());
+
+	std::atomic_bool paused = true;
+	std::atomic_int finished = 0;
+	for (int i = 0; i < 8; i++) {
+		pool.Enqueue([&] {
+			while (paused) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+			finished++;
+		});
+	}
+	EXPECT_TRUE(Eventually::Holds([&] { return pool.CountRunningTasks() == 4; }));
+	EXPECT_EQ(4u, pool.CountWorkers());
+	paused = false;
+	EXPECT_TRUE(Eventually::Holds([&] { return finished == 8; }));
+	EXPECT_TRUE(Eventually::Holds([&] { return pool.CountWorkers() == 1; }));
+
+	pool.Enqueue([&] { finished++; });
+	pool.Stop();
+	EXPECT_EQ(9, finished);
+}
+
+TEST_F(ElasticTaskPoolTest, BlockingScope) {
+	TaskPool pool{ "Test", ElasticTaskPoolUnitTest::ElasticOptions() };
+	std::atomic_bool blocked = false;
+	std::atomic_bool released = false;
+	std::atomic_bool ran = false;
+	pool.Enqueue([&] {
+		TaskPool::BlockingScope blocking{ pool };
+		blocked = true;
+		while (!released) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	});
+	EXPECT_TRUE(Eventually::Holds([&] { return blocked.load(); }));
+	pool.Enqueue([&] { ran = true; });
+	EXPECT_TRUE(Eventually::Holds([&] { return ran.load(); }));
+	released = true;
+}
+
+TEST_F(ElasticTaskPoolTest, ZeroIdleTimeoutNeverRetires) {
+	auto options = ElasticTaskPoolUnitTest::ElasticOptions();
+	options.idleTimeout = std::chrono::milliseconds::zero();
+	options.statistics = true;
+	TaskPool pool{ "Test", options };
+
+	std::atomic_bool paused = true;
+	std::atomic_int finished = 0;
+	for (int i = 0; i < 4; i++) {
+		pool.Enqueue([&] {
+			while (paused) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+			finished++;
+		});
+	}
+	EXPECT_TRUE(Eventually::Holds([&] { return pool.CountRunningTasks() == 4; }));
+	paused = false;
+	EXPECT_TRUE(Eventually::Holds([&] { return finished == 4; }));
+	// Twice the idle timeout of ElasticOptions; a worker that retires on idleness would be gone by now.
+	std::this_thread::sleep_for(std::chrono::milliseconds(200));
+	EXPECT_EQ(4u, pool.CountWorkers());
+	EXPECT_LT(pool.GetStatistics().wakeups, 100u);
+}
+
+TEST_F(ElasticTaskPoolTest, FixedByDefault) {
+	TaskPool pool{ "Test", 2 };
+	for (int i = 0; i < 10; i++) {
+		pool.Enqueue([] { std::this_thread::sleep_for(std::chrono::milliseconds(5)); });
+	}
+	EXPECT_EQ(2u, pool.CountWorkers());
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Task/EventBus.hpp"
+#include "Task/MessageTask.hpp"
+#include "Task/Payload.hpp"
+
+class EventBusTest : public ::testing::Test {};
+
+using namespace Framework::Task;
+
+namespace EventBusUnitTest {
+	enum class BusCommands : int {
+		STATUS = 0,
+		ALERT,
+		FLUSH,
+	};
+	using BusRequest = EventRequest<BusCommands, SharedPayload>;
+	using BusTask = MessageTask<BusCommands, BusRequest>;
+	using Bus = EventBus<BusCommands, BusRequest>;
+	using Args = MessageEventArgs<BusCommands, BusRequest>;
+
+	struct Status {
+		std::array<char, 256> text{};
+	};
+
+	struct Received {
+		std::mutex mutex;
+		std::vector<BusCommands> commands;
+		std::vector<const Status *> payloads;
+	};
+	inline std::array<Received, 3> busReceived;
+
+	inline BusTask::EventMap Recorder(std::size_t index) {
+		auto record = [index](const Args &args) {
+			Received &received = busReceived[index];
+			std::lock_guard<std::mutex> lock(received.mutex);
+			received.commands.push_back(args.GetRequest().GetCommand());
+			if (args.GetRequest().HasPayload()) {
+				received.payloads.push_back(&args.GetRequest().template GetPayloadAs<Status>());
+			}
+			return true;
+		};
+		return {
+			{ BusCommands::STATUS, { record } },
+			{ BusCommands::ALERT, { record } },
+			{ BusCommands::FLUSH, { [](const Args &) { return true; } } },
+		};
+	}
+
+	// Holds the first request sent to it until gate opens, keeping that publish in flight.
+	class GatedTask final : public Bus::Task {
+	public:
+		std::promise<void> entered;
+		std::shared_future<void> gate;
+
+		void Start() override {}
+		void Stop() override {}
+		void SendEvent(BusRequest &&) override {
+			entered.set_value();
+			gate.wait();
+		}
+		bool RpcEvent(BusRequest &&, std::chrono::milliseconds) override { return false; }
+	};
+
+	inline void Flush(std::vector<BusTask *> tasks) {
+		for (auto *task : tasks) {
+			EXPECT_TRUE(task->RpcEvent({ "Test", BusCommands::FLUSH }));
+		}
+	}
+}
+
+using namespace EventBusUnitTest;
+
+TEST_F(EventBusTest, FanOutSharesPayload) {
+	for (auto &received : busReceived) {
+		received.commands.clear();
+		received.payloads.clear();
+	}
+	BusTask first{ "EventBusTest0", Recorder(0) };
+	BusTask second{ "EventBusTest1", Recorder(1) };
+	BusTask third{ "EventBusTest2", Recorder(2) };
+	for (auto *task : { &first, &second, &third }) {
+		task->Start();
+	}
+	Bus bus;
+	bus.Subscribe(first, BusCommands::STATUS, BusCommands::ALERT);
+	bus.Subscribe(second, BusCommands::STATUS);
+	bus.Subscribe(third, BusCommands::ALERT);
+	auto overlapping = bus.Subscribe(third, BusCommands::STATUS, BusCommands::ALERT);
+	EXPECT_EQ(3u, bus.CountSubscribers(BusCommands::STATUS));
+	EXPECT_EQ(0u, bus.CountSubscribers(BusCommands::FLUSH));
+
+	BusRequest status{ "Test", BusCommands::STATUS, Status{} };
+	EXPECT_EQ(3u, bus.Publish(status));
+	EXPECT_EQ(2u, bus.Publish({ "Test", BusCommands::ALERT }));
+	bus.Unsubscribe(overlapping);
+	EXPECT_EQ(2u, bus.CountSubscribers(BusCommands::STATUS));
+	EXPECT_EQ(0u, bus.Publish({ "Test", BusCommands::FLUSH }));
+	Flush({ &first, &second, &third });
+
+	const Status *shared = &status.GetPayloadAs<Status>();
+	for (std::size_t i = 0; i < busReceived.size(); i++) {
+		ASSERT_EQ(1u, busReceived[i].payloads.size());
+		EXPECT_EQ(shared, busReceived[i].payloads.front());
+	}
+	EXPECT_EQ((std::vector<BusCommands>{ BusCommands::STATUS, BusCommands::ALERT }), busReceived[0].commands);
+	EXPECT_EQ((std::vector<BusCommands>{ BusCommands::STATUS }), busReceived[1].commands);
+	EXPECT_EQ((std::vector<BusCommands>{ BusCommands::STATUS, BusCommands::ALERT }), busReceived[2].commands);
+	EXPECT_EQ(1, status.GetPayload().UseCount());
+}
+
+TEST_F(EventBusTest, UnsubscribeTask) {
+	BusTask task{ "EventBusTest", Recorder(0) };
+	Bus bus;
+	bus.Subscribe(task, BusCommands::STATUS);
+	bus.Subscribe(task, BusCommands::ALERT);
+	bus.Unsubscribe(task);
+	EXPECT_EQ(0u, bus.CountSubscribers(BusCommands::STATUS));
+	EXPECT_EQ(0u, bus.Publish({ "Test", BusCommands::ALERT }));
+}
+
+TEST_F(EventBusTest, UnsubscribeWaitsForPublish) {
+	Bus bus;
+	std::atomic_bool publishing = true;
+	std::thread publisher([&] {
+		while (publishing) {
+			bus.Publish({ "Test", BusCommands::FLUSH });
+		}
+	});
+	for (int i = 0; i < 100; i++) {
+		auto task = std::make_unique<BusTask>("EventBusTest", Recorder(0));
+		task->Start();
+		bus.Subscribe(*task, BusCommands::FLUSH);
+		std::this_thread::yield();
+		bus.Unsubscribe(*task);
+		task->Stop();
+		task.reset();
+	}
+	publishing = false;
+	publisher.join();
+	EXPECT_EQ(0u, bus.CountSubscribers(BusCommands::FLUSH));
+}
+
+TEST_F(EventBusTest, UnsubscribeWaitsForPublishOnReplacedSnapshot) {
+	GatedTask gated;
+	std::promise<void> release;
+	gated.gate = release.get_future().share();
+	auto entered = gated.entered.get_future();
+	BusTask other{ "EventBusTest", Recorder(0) };
+	Bus bus;
+	bus.Subscribe(gated, BusCommands::FLUSH);
+	std::thread publisher([&bus] { bus.Publish({ "Test", BusCommands::FLUSH }); });
+	entered.wait();
+	// The publish still runs on the snapshot this subscription replaces.
+	bus.Subscribe(other, BusCommands::ALERT);
+	std::atomic_bool unsubscribed = false;
+	std::thread unsubscriber([&] {
+		bus.Unsubscribe(gated);
+		unsubscribed = true;
+	});
+	// Unsubscribe only returns early if it misses the publish, so a slow thread cannot fail this.
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	EXPECT_FALSE(unsubscribed);
+	release.set_value();
+	unsubscriber.join();
+	publisher.join();
+	EXPECT_TRUE(unsubscribed);
+	EXPECT_EQ(1u, bus.CountSubscribers(BusCommands::ALERT));
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <chrono>
+#include <thread>
+
+// Polls a condition that another thread makes true, giving up at a deadline far beyond any
+// expected latency so that a slow machine only slows the test down.
+namespace Eventually {
+	template <typename Condition>
+	inline bool Holds(Condition condition, std::chrono::milliseconds timeout = std::chrono::seconds(10)) {
+		const auto deadline = std::chrono::steady_clock::now() + timeout;
+		while (!condition()) {
+			if (std::chrono::steady_clock::now() >= deadline) {
+				return false;
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		return true;
+	}
+}
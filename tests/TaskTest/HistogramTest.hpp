@@ -0,0 +1,66 @@
+#pragma once
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Metrics/Histogram.hpp"
+
+class HistogramTest : public ::testing::Test {};
+
+using Framework::Metrics::Histogram;
+
+TEST_F(HistogramTest, SmallValuesAreExact) {
+	Histogram<> histogram;
+	for (uint64_t i = 1; i <= 10; i++) {
+		histogram.Record(i);
+	}
+	auto snapshot = histogram.Snapshot();
+	EXPECT_EQ(10u, snapshot.Count());
+	EXPECT_EQ(55u, snapshot.Sum());
+	EXPECT_EQ(1u, snapshot.Min());
+	EXPECT_EQ(10u, snapshot.Max());
+	EXPECT_EQ(5u, snapshot.Percentile(50));
+	EXPECT_EQ(10u, snapshot.Percentile(100));
+}
+
+TEST_F(HistogramTest, RelativeError) {
+	Histogram<> histogram;
+	for (uint64_t i = 1; i <= 100000; i++) {
+		histogram.Record(i * 1000);
+	}
+	auto snapshot = histogram.Snapshot();
+	for (double percentile : { 50.0, 90.0, 99.0, 99.9 }) {
+		double expected = percentile / 100.0 * 100000 * 1000;
+		double actual = static_cast<double>(snapshot.Percentile(percentile));
+		EXPECT_NEAR(expected, actual, expected / 16) << percentile;
+	}
+	EXPECT_EQ(UINT64_MAX, [] {
+		Histogram<> extreme;
+		extreme.Record(UINT64_MAX);
+		return extreme.Snapshot().Percentile(100);
+	}());
+}
+
+TEST_F(HistogramTest, ConcurrentRecordAndMerge) {
+	Histogram<> first, second;
+	std::vector<std::thread> threads;
+	for (int i = 0; i < 4; i++) {
+		threads.emplace_back([&] {
+			for (uint64_t value = 0; value < 10000; value++) {
+				first.Record(value);
+			}
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	second.Record(1000000);
+	auto merged = first.Snapshot();
+	merged.Merge(second.Snapshot());
+	EXPECT_EQ(40001u, merged.Count());
+	EXPECT_EQ(0u, merged.Min());
+	EXPECT_EQ(1000000u, merged.Max());
+	first.Reset();
+	EXPECT_EQ(0u, first.Snapshot().Count());
+}
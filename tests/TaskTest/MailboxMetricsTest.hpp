@@ -0,0 +1,83 @@
+#pragma once
+
+#include <chrono>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "Task/MessageTask.hpp"
+
+class MailboxMetricsTest : public ::testing::Test {};
+
+using namespace Framework::Task;
+
+namespace MailboxMetricsUnitTest {
+	enum class MetricsCommands : int {
+		FAST = 0,
+		SLOW,
+	};
+	using MetricsTask = MessageTask<MetricsCommands>;
+	using Args = MessageEventArgs<MetricsCommands>;
+
+	const MetricsTask::EventMap metricsEvents{
+		{ MetricsCommands::FAST, { [](const Args &) { return true; } } },
+		{ MetricsCommands::SLOW, { [](const Args &) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+			return true;
+		} } },
+	};
+}
+
+using namespace MailboxMetricsUnitTest;
+
+TEST_F(MailboxMetricsTest, Disabled) {
+	MetricsTask task{ "MailboxMetricsTest", metricsEvents };
+	task.Start();
+	EXPECT_TRUE(task.RpcEvent({ "Test", MetricsCommands::FAST }));
+	auto metrics = task.GetMailboxMetrics();
+	EXPECT_EQ(0u, metrics.processedEvents);
+	EXPECT_EQ(0u, metrics.queueWait.Count());
+	EXPECT_TRUE(metrics.dispatchTime.empty());
+}
+
+TEST_F(MailboxMetricsTest, Collects) {
+	MetricsTask task{ "MailboxMetricsTest", metricsEvents };
+	task.EnableMetrics();
+	task.Start();
+	for (int i = 0; i < 4; i++) {
+		task.SendEvent({ "Test", MetricsCommands::SLOW });
+	}
+	for (int i = 0; i < 9; i++) {
+		task.SendEvent({ "Test", MetricsCommands::FAST });
+	}
+	EXPECT_TRUE(task.RpcEvent({ "Test", MetricsCommands::FAST }));
+
+	auto metrics = task.GetMailboxMetrics();
+	EXPECT_EQ(14u, metrics.processedEvents);
+	EXPECT_EQ(14u, metrics.queueWait.Count());
+	EXPECT_GE(metrics.highWaterMark, 2u);
+	EXPECT_LE(metrics.highWaterMark, 14u);
+	EXPECT_EQ(0u, metrics.currentDepth);
+	ASSERT_EQ(2u, metrics.dispatchTime.size());
+	EXPECT_EQ(MetricsCommands::FAST, metrics.dispatchTime[0].first);
+	EXPECT_EQ(10u, metrics.dispatchTime[0].second.Count());
+	EXPECT_EQ(MetricsCommands::SLOW, metrics.dispatchTime[1].first);
+	EXPECT_EQ(4u, metrics.dispatchTime[1].second.Count());
+	EXPECT_GE(metrics.dispatchTime[1].second.Min(), 5000000u);
+	EXPECT_GE(metrics.queueWait.Max(), 15000000u);
+}
+
+TEST_F(MailboxMetricsTest, Batched) {
+	MetricsTask task{ "MailboxMetricsTest", metricsEvents };
+	task.EnableMetrics();
+	task.SetReceiveBatchSize(8);
+	task.Start();
+	task.SendEvent({ "Test", MetricsCommands::SLOW });
+	for (int i = 0; i < 5; i++) {
+		task.SendEvent({ "Test", MetricsCommands::FAST });
+	}
+	EXPECT_TRUE(task.RpcEvent({ "Test", MetricsCommands::FAST }));
+
+	auto metrics = task.GetMailboxMetrics();
+	EXPECT_EQ(7u, metrics.processedEvents);
+	EXPECT_GE(metrics.highWaterMark, 2u);
+}
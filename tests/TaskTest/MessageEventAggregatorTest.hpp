@@ -0,0 +1,106 @@
+#pragma once
+
+#include "gtest/gtest.h"
+#include "Task/MessageEventAggregator.hpp"
+
+class MessageEventAggregatorTest : public ::testing::Test {};
+
+using namespace Framework::Task;
+
+namespace MessageEventAggregatorUnitTest {
+	enum class Command : int {
+		NEGATIVE = -3,
+		FIRST = 0,
+		SECOND = 1,
+		UNKNOWN = 2,
+	};
+	using Aggregator = MessageEventAggregator<Command>;
+	using SparseAggregator = MessageEventAggregator<int64_t>;
+
+	bool Accept(const MessageEventArgs<Command> &) { return true; }
+	bool Reject(const MessageEventArgs<Command> &) { return false; }
+	bool AcceptSparse(const MessageEventArgs<int64_t> &) { return true; }
+}
+
+using namespace MessageEventAggregatorUnitTest;
+
+TEST_F(MessageEventAggregatorTest, DenseCommands) {
+	Aggregator aggregator{ {
+		{ Command::NEGATIVE, { Accept, 5 } },
+		{ Command::FIRST, { Accept } },
+		{ Command::SECOND, { Reject, 7 } },
+	} };
+	EventRequest<Command> request{ "Test", Command::FIRST };
+
+	EXPECT_TRUE(aggregator.Publish(Command::NEGATIVE, MessageEventArgs(&request)));
+	EXPECT_TRUE(aggregator.Publish(Command::FIRST, MessageEventArgs(&request)));
+	EXPECT_FALSE(aggregator.Publish(Command::SECOND, MessageEventArgs(&request)));
+	EXPECT_EQ(5, aggregator.GetNextState(Command::NEGATIVE));
+	EXPECT_EQ(Aggregator::KEEP_STATE, aggregator.GetNextState(Command::FIRST));
+	EXPECT_EQ(7, aggregator.Find(Command::SECOND)->GetNextState());
+	EXPECT_EQ(nullptr, aggregator.Find(Command::UNKNOWN));
+}
+
+TEST_F(MessageEventAggregatorTest, SparseCommands) {
+	SparseAggregator aggregator{ {
+		{ INT64_MIN, { AcceptSparse, 1 } },
+		{ -100000, { AcceptSparse, 2 } },
+		{ 7, { AcceptSparse, 3 } },
+		{ 1 << 20, { AcceptSparse, 4 } },
+		{ INT64_MAX, { AcceptSparse, 5 } },
+	} };
+
+	EXPECT_EQ(1, aggregator.GetNextState(INT64_MIN));
+	EXPECT_EQ(2, aggregator.GetNextState(-100000));
+	EXPECT_EQ(3, aggregator.GetNextState(7));
+	EXPECT_EQ(4, aggregator.GetNextState(1 << 20));
+	EXPECT_EQ(5, aggregator.GetNextState(INT64_MAX));
+	EXPECT_EQ(nullptr, aggregator.Find(0));
+	EXPECT_EQ(nullptr, aggregator.Find(8));
+	EXPECT_EQ(nullptr, aggregator.Find(INT64_MAX - 1));
+}
+
+TEST_F(MessageEventAggregatorTest, Empty) {
+	SparseAggregator aggregator{ {} };
+	EXPECT_EQ(nullptr, aggregator.Find(0));
+}
+
+TEST_F(MessageEventAggregatorTest, CopyKeepsTable) {
+	Aggregator original{ { { Command::FIRST, { Accept, 3 } } } };
+	Aggregator copy = original;
+	EXPECT_EQ(3, copy.GetNextState(Command::FIRST));
+}
+
+TEST_F(MessageEventAggregatorTest, UnhandledReturnsFalse) {
+	Aggregator aggregator{ { { Command::FIRST, { Accept } } } };
+	EventRequest<Command> request{ "Test", Command::UNKNOWN };
+
+	EXPECT_FALSE(aggregator.Publish(Command::UNKNOWN, MessageEventArgs(&request)));
+	EXPECT_EQ(Aggregator::KEEP_STATE, aggregator.GetNextState(Command::UNKNOWN));
+	EXPECT_EQ(1, aggregator.CountUnhandledEvents());
+}
+
+TEST_F(MessageEventAggregatorTest, FallbackHandler) {
+	Aggregator aggregator{ { { Command::FIRST, { Reject } } } };
+	EventRequest<Command> request{ "Test", Command::UNKNOWN };
+	Command fallbackCommand = Command::FIRST;
+	aggregator.SetFallbackHandler([&](const MessageEventArgs<Command> &args) {
+		fallbackCommand = args.GetRequest().GetCommand();
+		return true;
+	});
+
+	EXPECT_TRUE(aggregator.Publish(Command::UNKNOWN, MessageEventArgs(&request)));
+	EXPECT_EQ(Command::UNKNOWN, fallbackCommand);
+	EXPECT_FALSE(aggregator.Publish(Command::FIRST, MessageEventArgs(&request)));
+	EXPECT_EQ(1, aggregator.CountUnhandledEvents());
+}
+
+TEST_F(MessageEventAggregatorTest, ThrowPolicy) {
+	Aggregator aggregator{ { { Command::FIRST, { Accept } } } };
+	EventRequest<Command> request{ "Test", Command::UNKNOWN };
+	aggregator.SetUnhandledPolicy(Aggregator::UnhandledPolicy::THROW);
+
+	EXPECT_THROW(aggregator.Publish(Command::UNKNOWN, MessageEventArgs(&request)), Framework::Exception);
+	EXPECT_THROW(aggregator.GetNextState(Command::UNKNOWN), Framework::Exception);
+	EXPECT_EQ(1, aggregator.CountUnhandledEvents());
+}
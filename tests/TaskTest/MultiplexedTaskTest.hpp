@@ -0,0 +1,169 @@
+#pragma once
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Task/MessageTask.hpp"
+#include "Task/TaskPool.hpp"
+
+class MultiplexedTaskTest : public ::testing::Test {};
+
+using namespace Framework::Task;
+
+namespace MultiplexedUnitTest {
+	enum class ActorCommands : int {
+		STEP = 0,
+		ANSWER,
+		ASK,
+		ASK_BLOCKING,
+		ASK_OTHER_BLOCKING,
+	};
+	using ActorTask = MessageTask<ActorCommands>;
+	using Args = MessageEventArgs<ActorCommands>;
+
+	// A second instantiation, so a call between the two crosses task types.
+	enum class OracleCommands : int {
+		ANSWER = 0,
+	};
+	using OracleTask = MessageTask<OracleCommands>;
+
+	const OracleTask::EventMap oracleEvents{
+		{ OracleCommands::ANSWER, { [](const MessageEventArgs<OracleCommands> &args) { return args.SetResult(43); } } },
+	};
+
+	struct Actor {
+		std::atomic<int> running{ 0 };
+		int next{ 0 };
+		bool overlapped{ false };
+		bool reordered{ false };
+	};
+
+	struct Context {
+		std::mutex mutex;
+		std::set<std::thread::id> threads;
+		ActorTask *callee{ nullptr };
+		OracleTask *oracle{ nullptr };
+		std::promise<int> answered;
+	};
+	inline Context multiplexedContext;
+
+	inline AsyncHandler Ask() {
+		auto result = co_await multiplexedContext.callee->RpcEventAsync<int>({ "Caller", ActorCommands::ANSWER });
+		multiplexedContext.answered.set_value(result.Value());
+	}
+
+	const ActorTask::EventMap actorEvents{
+		{ ActorCommands::STEP, { [](const Args &args) {
+			auto [actor, sequence] = args.GetRequest().GetPayloadAs<std::pair<Actor *, int>>();
+			if (actor->running.fetch_add(1) != 0) {
+				actor->overlapped = true;
+			}
+			if (actor->next++ != sequence) {
+				actor->reordered = true;
+			}
+			{
+				std::lock_guard<std::mutex> lock(multiplexedContext.mutex);
+				multiplexedContext.threads.insert(std::this_thread::get_id());
+			}
+			actor->running.fetch_sub(1);
+			return true;
+		} } },
+		{ ActorCommands::ANSWER, { [](const Args &args) { return args.SetResult(42); } } },
+		{ ActorCommands::ASK, { [](const Args &) {
+			Ask();
+			return true;
+		} } },
+		{ ActorCommands::ASK_BLOCKING, { [](const Args &) {
+			auto result = multiplexedContext.callee->RpcEvent<int>({ "Caller", ActorCommands::ANSWER });
+			multiplexedContext.answered.set_value(result.Value());
+			return true;
+		} } },
+		{ ActorCommands::ASK_OTHER_BLOCKING, { [](const Args &) {
+			auto result = multiplexedContext.oracle->RpcEvent<int>({ "Caller", OracleCommands::ANSWER });
+			multiplexedContext.answered.set_value(result.Value());
+			return true;
+		} } },
+	};
+}
+
+using namespace MultiplexedUnitTest;
+
+TEST_F(MultiplexedTaskTest, SerialAndOrderedPerTask) {
+	constexpr int TASKS = 40;
+	constexpr int EVENTS = 200;
+	TaskPool executor{ "MultiplexedTaskTest", 2 };
+	multiplexedContext.threads.clear();
+	std::vector<std::unique_ptr<ActorTask>> tasks;
+	std::vector<Actor> actors(TASKS);
+	for (int i = 0; i < TASKS; i++) {
+		tasks.push_back(std::make_unique<ActorTask>("MultiplexedTaskTest" + std::to_string(i), actorEvents, executor));
+		tasks.back()->Start();
+		EXPECT_TRUE(tasks.back()->IsRunning());
+	}
+	for (int sequence = 0; sequence < EVENTS; sequence++) {
+		for (int i = 0; i < TASKS; i++) {
+			tasks[i]->SendEvent({ "Test", ActorCommands::STEP, std::pair<Actor *, int>{ &actors[i], sequence } });
+		}
+	}
+	for (int i = 0; i < TASKS; i++) {
+		EXPECT_TRUE(tasks[i]->RpcEvent({ "Test", ActorCommands::STEP, std::pair<Actor *, int>{ &actors[i], EVENTS } }));
+		EXPECT_EQ(EVENTS + 1, actors[i].next);
+		EXPECT_FALSE(actors[i].overlapped);
+		EXPECT_FALSE(actors[i].reordered);
+	}
+	EXPECT_LE(multiplexedContext.threads.size(), 2u);
+	EXPECT_EQ(0u, multiplexedContext.threads.count(std::this_thread::get_id()));
+	tasks.front()->Stop();
+	EXPECT_FALSE(tasks.front()->IsRunning());
+	tasks.clear();
+}
+
+TEST_F(MultiplexedTaskTest, AsyncRpcOnOneWorker) {
+	TaskPool executor{ "MultiplexedTaskTest", 1 };
+	ActorTask callee{ "MultiplexedCallee", actorEvents, executor };
+	ActorTask caller{ "MultiplexedCaller", actorEvents, executor };
+	callee.Start();
+	caller.Start();
+	multiplexedContext.callee = &callee;
+	multiplexedContext.answered = {};
+	caller.SendEvent({ "Test", ActorCommands::ASK });
+	EXPECT_EQ(42, multiplexedContext.answered.get_future().get());
+}
+
+TEST_F(MultiplexedTaskTest, BlockingRpcGrowsElasticExecutor) {
+	TaskPool::Options options;
+	options.concurrency = 1;
+	options.maxConcurrency = 2;
+	TaskPool executor{ "MultiplexedTaskTest", options };
+	ActorTask callee{ "MultiplexedCallee", actorEvents, executor };
+	ActorTask caller{ "MultiplexedCaller", actorEvents, executor };
+	callee.Start();
+	caller.Start();
+	multiplexedContext.callee = &callee;
+	multiplexedContext.answered = {};
+	caller.SendEvent({ "Test", ActorCommands::ASK_BLOCKING });
+	EXPECT_EQ(42, multiplexedContext.answered.get_future().get());
+}
+
+TEST_F(MultiplexedTaskTest, BlockingRpcAcrossTaskTypesGrowsElasticExecutor) {
+	TaskPool::Options options;
+	options.concurrency = 1;
+	options.maxConcurrency = 2;
+	// Queued work alone never grows the pool here; only the blocked caller can.
+	options.growThreshold = 1000;
+	TaskPool executor{ "MultiplexedTaskTest", options };
+	OracleTask oracle{ "MultiplexedOracle", oracleEvents, executor };
+	ActorTask caller{ "MultiplexedCaller", actorEvents, executor };
+	oracle.Start();
+	caller.Start();
+	multiplexedContext.oracle = &oracle;
+	multiplexedContext.answered = {};
+	caller.SendEvent({ "Test", ActorCommands::ASK_OTHER_BLOCKING });
+	EXPECT_EQ(43, multiplexedContext.answered.get_future().get());
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Task/Parallel.hpp"
+
+class ParallelTest : public ::testing::Test {};
+
+using namespace Framework::Task;
+
+TEST_F(ParallelTest, For) {
+	TaskPool pool{ "Test", 4, TaskPool::Scheduler::WORK_STEALING };
+	std::vector<int> values(10000, 0);
+	ParallelFor(pool, 0, static_cast<int>(values.size()), [&values](int i) {
+		values[i] = i * 2;
+	});
+	for (int i = 0; i < static_cast<int>(values.size()); i++) {
+		ASSERT_EQ(i * 2, values[i]);
+	}
+	ParallelFor(pool, 5, 5, [](int) { FAIL(); });
+}
+
+TEST_F(ParallelTest, ForNested) {
+	TaskPool pool{ "Test", 2 };
+	std::atomic_int counter = 0;
+	ParallelFor(pool, 0, 8, [&](int) {
+		ParallelFor(pool, 0, 100, [&](int) { counter++; }, 10);
+	}, 1);
+	EXPECT_EQ(800, counter);
+}
+
+TEST_F(ParallelTest, ForException) {
+	TaskPool pool{ "Test", 4 };
+	EXPECT_THROW(ParallelFor(pool, 0, 1000, [](int i) {
+		if (i == 500) {
+			throw std::runtime_error("failed");
+		}
+	}, 10), std::runtime_error);
+}
+
+TEST_F(ParallelTest, Reduce) {
+	TaskPool pool{ "Test", 4 };
+	auto sum = ParallelReduce(pool, int64_t{ 1 }, int64_t{ 100001 }, int64_t{ 0 },
+		[](int64_t i) { return i; }, [](int64_t a, int64_t b) { return a + b; });
+	EXPECT_EQ(int64_t{ 5000050000 }, sum);
+
+	std::vector<std::string> words{ "a", "b", "c", "d", "e" };
+	auto joined = ParallelReduce(pool, std::size_t{ 0 }, words.size(), std::string{},
+		[&words](std::size_t i) { return words[i]; },
+		[](std::string a, const std::string &b) { return a + b; }, 1);
+	EXPECT_EQ("abcde", joined);
+}
+
+TEST_F(ParallelTest, Sort) {
+	TaskPool pool{ "Test", 4, TaskPool::Scheduler::WORK_STEALING };
+	std::vector<int> values(100000);
+	std::mt19937 random{ 42 };
+	for (auto &value : values) {
+		value = static_cast<int>(random());
+	}
+	auto expected = values;
+	std::sort(expected.begin(), expected.end(), std::greater<>());
+	ParallelSort(pool, values.begin(), values.end(), std::greater<>());
+	EXPECT_EQ(expected, values);
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <thread>
+
+// Helpers for tests that hold an event task inside a handler while they fill its mailbox.
+namespace ParkedTask {
+	template <typename TaskType>
+	inline void WaitForDepth(TaskType &task, std::size_t depth) {
+		while (task.GetMailboxMetrics().currentDepth != depth) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+	// Starts task and parks it in the handler of command, which must wait on gate, until the
+	// returned promise is set.
+	template <typename TaskType, typename Command>
+	inline std::promise<void> Park(TaskType &task, std::shared_future<void> &gate, Command command) {
+		std::promise<void> release;
+		gate = release.get_future().share();
+		task.Start();
+		task.SendEvent({ "Test", command });
+		WaitForDepth(task, 0);
+		return release;
+	}
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <array>
+
+#include "gtest/gtest.h"
+#include "Task/Payload.hpp"
+#include "Task/EventRequest.hpp"
+#include "Task/MessageTask.hpp"
+#include "Message/RingBuffer.hpp"
+#include "Message/SynchronizedDeque.hpp"
+
+class PayloadTest : public ::testing::Test {};
+
+using namespace Framework::Task;
+
+namespace PayloadUnitTest {
+	struct Position {
+		int x;
+		int y;
+	};
+	using LargeData = std::array<char, 128>;
+
+	template <typename Queue, typename M>
+	concept SendsCopy = requires(Queue &queue, const M &message) { queue.Send(message); };
+
+	template <typename Task, typename M>
+	concept SendsEventCopy = requires(Task &task, const M &message) { task.SendEvent(message); };
+
+	template <typename Task, typename M>
+	concept RpcsCopy = requires(Task &task, const M &message) { task.RpcEvent(message); };
+}
+
+TEST_F(PayloadTest, Empty) {
+	Payload<> payload;
+	EXPECT_FALSE(payload.HasValue());
+	EXPECT_FALSE(payload.Holds<int>());
+}
+
+TEST_F(PayloadTest, InlineValue) {
+	Payload<> payload{ PayloadUnitTest::Position{ 1, 2 } };
+	EXPECT_TRUE(Payload<>::IsInline<PayloadUnitTest::Position>);
+	EXPECT_TRUE(payload.Holds<PayloadUnitTest::Position>());
+	EXPECT_EQ(2, payload.As<PayloadUnitTest::Position>().y);
+}
+
+TEST_F(PayloadTest, HeapValue) {
+	PayloadUnitTest::LargeData data{};
+	data[100] = 'x';
+	Payload<> payload{ data };
+	EXPECT_FALSE(Payload<>::IsInline<PayloadUnitTest::LargeData>);
+	EXPECT_EQ('x', payload.As<PayloadUnitTest::LargeData>()[100]);
+}
+
+TEST_F(PayloadTest, TypeMismatch) {
+	Payload<> payload{ 42 };
+	EXPECT_THROW(payload.As<long>(), Framework::Exception);
+}
+
+TEST_F(PayloadTest, MoveOnly) {
+	Payload<> payload{ std::make_unique<int>(7) };
+	Payload<> moved{ std::move(payload) };
+	EXPECT_FALSE(payload.HasValue());
+	EXPECT_EQ(7, *moved.As<std::unique_ptr<int>>());
+
+	Payload<> assigned;
+	assigned = std::move(moved);
+	EXPECT_FALSE(moved.HasValue());
+	EXPECT_EQ(7, *assigned.As<std::unique_ptr<int>>());
+}
+
+TEST_F(PayloadTest, DestroysValue) {
+	auto shared = std::make_shared<int>(1);
+	{
+		Payload<> payload{ shared };
+		EXPECT_EQ(2, shared.use_count());
+		payload.Emplace<std::string>("replaced");
+		EXPECT_EQ(1, shared.use_count());
+	}
+	EXPECT_EQ(1, shared.use_count());
+}
+
+TEST_F(PayloadTest, EventRequestPayload) {
+	EventRequest<int, Payload<>> request{ "Test", 1, PayloadUnitTest::Position{ 3, 4 } };
+	EXPECT_TRUE(request.HasPayload());
+	EXPECT_EQ(3, request.GetPayloadAs<PayloadUnitTest::Position>().x);
+
+	EventRequest<int, Payload<>> moved{ std::move(request) };
+	EXPECT_EQ(4, moved.GetPayloadAs<PayloadUnitTest::Position>().y);
+	EXPECT_FALSE(std::is_copy_constructible_v<decltype(moved)>);
+}
+
+TEST_F(PayloadTest, MoveOnlyRequestsRejectCopies) {
+	using namespace PayloadUnitTest;
+	using Request = EventRequest<int, Payload<>>;
+	static_assert(!SendsEventCopy<MessageTask<int, Request>, Request>);
+	static_assert(!RpcsCopy<MessageTask<int, Request>, Request>);
+	static_assert(!SendsCopy<Framework::Message::RingBuffer<Request>, Request>);
+	static_assert(!SendsCopy<Framework::Message::SynchronizedDeque<Request>, Request>);
+	static_assert(SendsEventCopy<MessageTask<int>, EventRequest<int>>);
+	static_assert(RpcsCopy<MessageTask<int>, EventRequest<int>>);
+	static_assert(SendsCopy<Framework::Message::RingBuffer<EventRequest<int>>, EventRequest<int>>);
+}
+
+TEST_F(PayloadTest, SharedPayload) {
+	SharedPayload payload{ PayloadUnitTest::LargeData{} };
+	SharedPayload copy{ payload };
+	EXPECT_EQ(2, payload.UseCount());
+	EXPECT_EQ(&payload.As<PayloadUnitTest::LargeData>(), &copy.As<PayloadUnitTest::LargeData>());
+	EXPECT_THROW(copy.As<int>(), Framework::Exception);
+	EXPECT_FALSE(SharedPayload{}.HasValue());
+
+	EventRequest<int, SharedPayload> request{ "Test", 1, PayloadUnitTest::Position{ 3, 4 } };
+	EventRequest<int, SharedPayload> copied{ request };
+	EXPECT_EQ(&request.GetPayloadAs<PayloadUnitTest::Position>(), &copied.GetPayloadAs<PayloadUnitTest::Position>());
+}
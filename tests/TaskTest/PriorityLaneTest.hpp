@@ -0,0 +1,157 @@
+#pragma once
+
+#include <future>
+#include <mutex>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Task/MessageTask.hpp"
+#include "Task/TaskPool.hpp"
+#include "ParkedTask.hpp"
+
+class PriorityLaneTest : public ::testing::Test {};
+
+using namespace Framework::Task;
+
+namespace PriorityLaneUnitTest {
+	enum class LaneCommands : int {
+		BLOCK = 0,
+		RECORD,
+	};
+	using LaneTask = MessageTask<LaneCommands>;
+	using Args = MessageEventArgs<LaneCommands>;
+
+	inline const LaneTask::Mailbox lanes{ .priorityLanes = true };
+
+	struct Context {
+		std::shared_future<void> release;
+		std::mutex mutex;
+		std::vector<int> recorded;
+	};
+	inline Context laneContext;
+
+	const LaneTask::EventMap laneEvents{
+		{ LaneCommands::BLOCK, { [](const Args &) {
+			laneContext.release.wait();
+			return true;
+		} } },
+		{ LaneCommands::RECORD, { [](const Args &args) {
+			std::lock_guard<std::mutex> lock(laneContext.mutex);
+			laneContext.recorded.push_back(args.GetRequest().GetPayloadAs<int>());
+			return true;
+		} } },
+	};
+
+	inline std::promise<void> Park(LaneTask &task) {
+		laneContext.recorded.clear();
+		return ParkedTask::Park(task, laneContext.release, LaneCommands::BLOCK);
+	}
+
+	inline void SendBacklog(LaneTask &task) {
+		for (int i = 1; i <= 3; i++) {
+			task.SendEvent({ "Test", LaneCommands::RECORD, i });
+		}
+		task.SendEvent({ "Test", LaneCommands::RECORD, 100 }, TaskPriority::LOW);
+		task.SendEvent({ "Test", LaneCommands::RECORD, 0 }, TaskPriority::HIGH);
+	}
+
+	// Parks task behind a backlog and a pending RPC, then stops it with StopNow.
+	inline void ExpectStopNowSkipsBacklog(const LaneTask::Mailbox &mailbox) {
+		static constexpr int BACKLOG = 1000;
+		LaneTask task{ "PriorityLaneTest", laneEvents, mailbox };
+		auto release = Park(task);
+		for (int i = 0; i < BACKLOG; i++) {
+			task.SendEvent({ "Test", LaneCommands::RECORD, i });
+		}
+		auto pending = std::async(std::launch::async, [&task] {
+			return task.RpcEvent({ "Test", LaneCommands::RECORD, BACKLOG });
+		});
+		ParkedTask::WaitForDepth(task, BACKLOG + 1);
+		auto stopped = std::async(std::launch::async, [&task] { return task.StopNow(); });
+		ParkedTask::WaitForDepth(task, BACKLOG + 2);
+		release.set_value();
+		EXPECT_EQ(static_cast<std::size_t>(BACKLOG + 1), stopped.get());
+		EXPECT_FALSE(task.IsRunning());
+		EXPECT_TRUE(laneContext.recorded.empty());
+		EXPECT_EQ(static_cast<std::size_t>(BACKLOG + 1), task.GetMailboxMetrics().abandonedEvents);
+		try {
+			pending.get();
+			FAIL();
+		} catch (const Framework::Exception &e) {
+			EXPECT_EQ(Framework::Error::Code::InvalidOperation, e.GetCode());
+		}
+	}
+}
+
+using namespace PriorityLaneUnitTest;
+using ParkedTask::WaitForDepth;
+
+TEST_F(PriorityLaneTest, HighFirstLowLast) {
+	LaneTask task{ "PriorityLaneTest", laneEvents, lanes };
+	auto release = Park(task);
+	SendBacklog(task);
+	EXPECT_EQ(5u, task.GetMailboxMetrics().currentDepth);
+	release.set_value();
+	WaitForDepth(task, 0);
+	task.Stop();
+	EXPECT_EQ((std::vector<int>{ 0, 1, 2, 3, 100 }), laneContext.recorded);
+}
+
+TEST_F(PriorityLaneTest, LowRunsOnIdleMailbox) {
+	LaneTask task{ "PriorityLaneTest", laneEvents, lanes };
+	task.Start();
+	laneContext.recorded.clear();
+	task.SendEvent({ "Test", LaneCommands::RECORD, 7 }, TaskPriority::LOW);
+	WaitForDepth(task, 0);
+	EXPECT_TRUE(task.RpcEvent({ "Test", LaneCommands::RECORD, 8 }));
+	EXPECT_EQ((std::vector<int>{ 7, 8 }), laneContext.recorded);
+}
+
+TEST_F(PriorityLaneTest, StopNowSkipsBacklog) {
+	ExpectStopNowSkipsBacklog(lanes);
+}
+
+TEST_F(PriorityLaneTest, StopNowSkipsBacklogWithoutLanes) {
+	ExpectStopNowSkipsBacklog({});
+}
+
+TEST_F(PriorityLaneTest, StopHandlesBacklog) {
+	LaneTask task{ "PriorityLaneTest", laneEvents, lanes };
+	auto release = Park(task);
+	for (int i = 1; i <= 3; i++) {
+		task.SendEvent({ "Test", LaneCommands::RECORD, i });
+	}
+	auto stopped = std::async(std::launch::async, [&task] { task.Stop(); });
+	WaitForDepth(task, 4);
+	release.set_value();
+	stopped.get();
+	EXPECT_EQ((std::vector<int>{ 1, 2, 3 }), laneContext.recorded);
+	EXPECT_EQ(0u, task.GetMailboxMetrics().abandonedEvents);
+}
+
+TEST_F(PriorityLaneTest, HighFirstOnExecutor) {
+	TaskPool executor{ "PriorityLaneTest", 1 };
+	LaneTask task{ "PriorityLaneTest", laneEvents, executor, lanes };
+	auto release = Park(task);
+	SendBacklog(task);
+	release.set_value();
+	WaitForDepth(task, 0);
+	task.Stop();
+	EXPECT_EQ((std::vector<int>{ 0, 1, 2, 3, 100 }), laneContext.recorded);
+}
+
+TEST_F(PriorityLaneTest, NeedsLanes) {
+	LaneTask task{ "PriorityLaneTest", laneEvents };
+	task.Start();
+	laneContext.recorded.clear();
+	try {
+		task.SendEvent({ "Test", LaneCommands::RECORD, 1 }, TaskPriority::HIGH);
+		FAIL();
+	} catch (const Framework::Exception &e) {
+		EXPECT_EQ(Framework::Error::Code::InvalidOperation, e.GetCode());
+	}
+	task.SendEvent({ "Test", LaneCommands::RECORD, 2 }, TaskPriority::NORMAL);
+	EXPECT_TRUE(task.RpcEvent({ "Test", LaneCommands::RECORD, 3 }));
+	EXPECT_EQ((std::vector<int>{ 2, 3 }), laneContext.recorded);
+	task.Stop();
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Task/MessageTask.hpp"
+
+class RpcEventAsyncTest : public ::testing::Test {};
+
+using namespace Framework::Task;
+
+namespace RpcEventAsyncUnitTest {
+	enum class AsyncCommands : int {
+		ANSWER = 0,
+		THROW,
+		CALL,
+		PING,
+		CALL_THEN_THROW,
+	};
+	using AsyncTask = MessageTask<AsyncCommands>;
+	using Args = MessageEventArgs<AsyncCommands>;
+
+	struct Context {
+		AsyncTask *callee{ nullptr };
+		std::vector<AsyncCommands> order;
+		std::thread::id callerThread;
+		std::thread::id resumedThread;
+		std::promise<int> resumed;
+	};
+	inline Context context;
+
+	inline AsyncHandler CallCallee() {
+		auto result = co_await context.callee->RpcEventAsync<int>({ "Caller", AsyncCommands::ANSWER });
+		context.resumedThread = std::this_thread::get_id();
+		context.order.push_back(AsyncCommands::CALL);
+		context.resumed.set_value(result.Value());
+	}
+
+	inline AsyncHandler CallCalleeThenThrow() {
+		co_await context.callee->RpcEventAsync<int>({ "Caller", AsyncCommands::ANSWER });
+		throw std::runtime_error("resumed handler failed");
+	}
+
+	const AsyncTask::EventMap calleeEvents{
+		{ AsyncCommands::ANSWER, { [](const Args &args) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+			return args.SetResult(7);
+		} } },
+		{ AsyncCommands::THROW, { [](const Args &) -> bool {
+			throw std::runtime_error("handler failed");
+		} } },
+	};
+
+	const AsyncTask::EventMap callerEvents{
+		{ AsyncCommands::CALL, { [](const Args &) {
+			context.callerThread = std::this_thread::get_id();
+			CallCallee();
+			return true;
+		} } },
+		{ AsyncCommands::PING, { [](const Args &) {
+			context.order.push_back(AsyncCommands::PING);
+			return true;
+		} } },
+		{ AsyncCommands::CALL_THEN_THROW, { [](const Args &) {
+			CallCalleeThenThrow();
+			return true;
+		} } },
+	};
+}
+
+using namespace RpcEventAsyncUnitTest;
+
+TEST_F(RpcEventAsyncTest, CallbackOutsideTask) {
+	AsyncTask callee{ "RpcEventAsyncTest", calleeEvents };
+	callee.Start();
+
+	std::promise<std::pair<Framework::Error::Code, std::thread::id>> done;
+	callee.RpcEventAsync<int>({ "Test", AsyncCommands::ANSWER }, [&done](RpcResult<int> result) {
+		EXPECT_EQ(7, result.Value());
+		done.set_value({ result.GetCode(), std::this_thread::get_id() });
+	});
+	auto [code, thread] = done.get_future().get();
+	EXPECT_EQ(Framework::Error::Code::Success, code);
+	EXPECT_NE(std::this_thread::get_id(), thread);
+}
+
+TEST_F(RpcEventAsyncTest, HandlerException) {
+	AsyncTask callee{ "RpcEventAsyncTest", calleeEvents };
+	callee.Start();
+
+	std::promise<RpcResult<int>> done;
+	callee.RpcEventAsync<int>({ "Test", AsyncCommands::THROW }, [&done](RpcResult<int> result) {
+		done.set_value(std::move(result));
+	});
+	auto result = done.get_future().get();
+	EXPECT_TRUE(result.GetException());
+	EXPECT_THROW(result.Value(), std::runtime_error);
+}
+
+TEST_F(RpcEventAsyncTest, CoroutineResumesOnCaller) {
+	context = {};
+	AsyncTask callee{ "RpcEventAsyncCallee", calleeEvents };
+	AsyncTask caller{ "RpcEventAsyncCaller", callerEvents };
+	context.callee = &callee;
+	callee.Start();
+	caller.Start();
+
+	auto resumed = context.resumed.get_future();
+	caller.SendEvent({ "Test", AsyncCommands::CALL });
+	caller.SendEvent({ "Test", AsyncCommands::PING });
+	EXPECT_EQ(7, resumed.get());
+
+	EXPECT_EQ(context.callerThread, context.resumedThread);
+	EXPECT_EQ((std::vector<AsyncCommands>{ AsyncCommands::PING, AsyncCommands::CALL }), context.order);
+}
+
+TEST_F(RpcEventAsyncTest, ResumedHandlerThrows) {
+	context = {};
+	AsyncTask callee{ "RpcEventAsyncCallee", calleeEvents };
+	AsyncTask caller{ "RpcEventAsyncCaller", callerEvents };
+	context.callee = &callee;
+	std::promise<std::string> failed;
+	caller.SetOnError([&failed](std::exception_ptr exception) {
+		try {
+			std::rethrow_exception(exception);
+		} catch (const std::runtime_error &e) {
+			failed.set_value(e.what());
+		}
+	});
+	callee.Start();
+	caller.Start();
+
+	caller.SendEvent({ "Test", AsyncCommands::CALL_THEN_THROW });
+	EXPECT_EQ("resumed handler failed", failed.get_future().get());
+	EXPECT_EQ(1u, caller.CountAsyncErrors());
+	EXPECT_EQ(0u, callee.CountAsyncErrors());
+}
+
+TEST_F(RpcEventAsyncTest, ResumesInlineAfterCallerStopped) {
+	context = {};
+	AsyncTask callee{ "RpcEventAsyncCallee", calleeEvents };
+	AsyncTask caller{ "RpcEventAsyncCaller", callerEvents };
+	context.callee = &callee;
+	callee.Start();
+	caller.Start();
+
+	auto resumed = context.resumed.get_future();
+	EXPECT_TRUE(caller.RpcEvent({ "Test", AsyncCommands::CALL }));
+	caller.Stop();
+	ASSERT_EQ(std::future_status::ready, resumed.wait_for(std::chrono::seconds(5)));
+	EXPECT_EQ(7, resumed.get());
+	EXPECT_NE(context.callerThread, context.resumedThread);
+}
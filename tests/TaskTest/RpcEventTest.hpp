@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Task/MessageTask.hpp"
+#include "Eventually.hpp"
+
+class RpcEventTest : public ::testing::Test {};
+
+using namespace Framework::Task;
+
+namespace RpcEventUnitTest {
+	enum class Commands : int {
+		ANSWER = 0,
+		NO_RESULT,
+		REJECT,
+		SLOW,
+	};
+	using RpcTask = MessageTask<Commands>;
+	using Args = MessageEventArgs<Commands>;
+
+	const RpcTask::EventMap events{
+		{ Commands::ANSWER, { [](const Args &args) {
+			return args.SetResult(std::string("answer"));
+		} } },
+		{ Commands::NO_RESULT, { [](const Args &args) {
+			return !args.SetResult(42);
+		} } },
+		{ Commands::REJECT, { [](const Args &args) {
+			args.SetResult(std::string("partial"));
+			return false;
+		} } },
+		{ Commands::SLOW, { [](const Args &) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(300));
+			return true;
+		} } },
+	};
+}
+
+using namespace RpcEventUnitTest;
+
+TEST_F(RpcEventTest, TypedResult) {
+	RpcTask task{ "RpcEventTest", events };
+	task.Start();
+
+	auto result = task.RpcEvent<std::string>({ "Test", Commands::ANSWER });
+	EXPECT_TRUE(result.IsSuccess());
+	EXPECT_EQ("answer", result.Value());
+}
+
+TEST_F(RpcEventTest, NoResult) {
+	RpcTask task{ "RpcEventTest", events };
+	task.Start();
+
+	auto result = task.RpcEvent<std::string>({ "Test", Commands::NO_RESULT });
+	EXPECT_EQ(Framework::Error::Code::NoResult, result.GetCode());
+	EXPECT_FALSE(result.HasValue());
+	EXPECT_THROW(result.Value(), Framework::Exception);
+}
+
+TEST_F(RpcEventTest, Rejected) {
+	RpcTask task{ "RpcEventTest", events };
+	task.Start();
+
+	auto result = task.RpcEvent<std::string>({ "Test", Commands::REJECT });
+	EXPECT_EQ(Framework::Error::Code::Rejected, result.GetCode());
+	EXPECT_EQ("partial", result.Value());
+}
+
+TEST_F(RpcEventTest, Timeout) {
+	RpcTask task{ "RpcEventTest", events };
+	task.Start();
+
+	auto result = task.RpcEvent<int>({ "Test", Commands::SLOW }, std::chrono::milliseconds(50));
+	EXPECT_EQ(Framework::Error::Code::Timeout, result.GetCode());
+	EXPECT_TRUE(task.RpcEvent({ "Test", Commands::NO_RESULT }));
+}
+
+TEST_F(RpcEventTest, AfterStop) {
+	RpcTask task{ "RpcEventTest", events };
+	task.Start();
+	task.Stop();
+	try {
+		task.RpcEvent({ "Test", Commands::ANSWER });
+		FAIL();
+	} catch (const Framework::Exception &e) {
+		EXPECT_EQ(Framework::Error::Code::InvalidOperation, e.GetCode());
+	}
+	EXPECT_THROW(task.RpcEvent<std::string>({ "Test", Commands::ANSWER }), Framework::Exception);
+}
+
+TEST_F(RpcEventTest, RacingStop) {
+	RpcTask task{ "RpcEventTest", events };
+	task.Start();
+	std::atomic_int answered = 0;
+	std::vector<std::thread> callers;
+	for (int i = 0; i < 4; i++) {
+		callers.emplace_back([&task, &answered] {
+			try {
+				while (task.RpcEvent<std::string>({ "Test", Commands::ANSWER }).IsSuccess()) {
+					answered++;
+				}
+			} catch (const Framework::Exception &e) {
+				EXPECT_EQ(Framework::Error::Code::InvalidOperation, e.GetCode());
+			}
+		});
+	}
+	EXPECT_TRUE(Eventually::Holds([&] { return answered >= 40; }));
+	task.Stop();
+	for (auto &caller : callers) {
+		caller.join();
+	}
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <future>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Task/TaskPool.hpp"
+
+class TaskFutureTest : public ::testing::Test {};
+
+using namespace Framework::Task;
+
+TEST_F(TaskFutureTest, Submit) {
+	TaskPool pool{ "Test", 2 };
+	auto future = pool.Submit([](int a, int b) { return a + b; }, 1, 2);
+	EXPECT_EQ(3, future.Get());
+
+	bool ran = false;
+	pool.Submit([&ran] { ran = true; }).Get();
+	EXPECT_TRUE(ran);
+}
+
+TEST_F(TaskFutureTest, Then) {
+	TaskPool pool{ "Test", 2, TaskPool::Scheduler::WORK_STEALING };
+	auto future = pool.Submit([] { return 20; })
+		.Then([](int value) { return value + 1; })
+		.Then([](int value) { return std::to_string(value * 2); });
+	EXPECT_EQ("42", future.Get());
+}
+
+TEST_F(TaskFutureTest, ExceptionSkipsContinuation) {
+	TaskPool pool{ "Test", 2 };
+	bool called = false;
+	auto future = pool.Submit([]() -> int { throw std::runtime_error("failed"); })
+		.Then([&called](int value) { called = true; return value; });
+	EXPECT_THROW(future.Get(), std::runtime_error);
+	EXPECT_FALSE(called);
+}
+
+TEST_F(TaskFutureTest, ThenAfterStop) {
+	std::optional<TaskFuture<int>> future;
+	{
+		TaskPool pool{ "Test", 2 };
+		future = pool.Submit([] { return 20; });
+		future->Wait();
+		pool.Stop();
+		EXPECT_EQ(21, pool.Submit([] { return 21; }).Get());
+	}
+	EXPECT_EQ(42, future->Then([](int value) { return value * 2 + 2; }).Get());
+}
+
+TEST_F(TaskFutureTest, WhenAll) {
+	TaskPool pool{ "Test", 4, TaskPool::Scheduler::WORK_STEALING };
+	std::vector<TaskFuture<int>> futures;
+	for (int i = 0; i < 16; i++) {
+		futures.push_back(pool.Submit([i] { return i * i; }));
+	}
+	auto all = WhenAll(std::move(futures)).Then([](std::vector<int> values) {
+		int sum = 0;
+		for (int value : values) {
+			sum += value;
+		}
+		return sum;
+	});
+	EXPECT_EQ(1240, all.Get());
+
+	EXPECT_TRUE(WhenAll(std::vector<TaskFuture<int>>{}).Get().empty());
+}
+
+TEST_F(TaskFutureTest, WhenAny) {
+	TaskPool pool{ "Test", 2 };
+	std::promise<void> release;
+	std::shared_future<void> gate = release.get_future().share();
+	std::vector<TaskFuture<int>> futures;
+	futures.push_back(pool.Submit([gate] {
+		gate.wait();
+		return 1;
+	}));
+	futures.push_back(pool.Submit([] { return 2; }));
+	std::size_t first = WhenAny(futures).Get();
+	release.set_value();
+	EXPECT_EQ(1u, first);
+	EXPECT_EQ(2, futures[first].Get());
+	EXPECT_EQ(1, futures[0].Get());
+}
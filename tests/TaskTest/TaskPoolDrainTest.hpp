@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Task/TaskPool.hpp"
+#include "Eventually.hpp"
+
+class TaskPoolDrainTest : public ::testing::Test {};
+
+using namespace Framework::Task;
+
+TEST_F(TaskPoolDrainTest, DrainWaitsForChildren) {
+	for (auto scheduler : { TaskPool::Scheduler::SHARED_QUEUE, TaskPool::Scheduler::WORK_STEALING }) {
+		TaskPool pool{ "Test", 2, scheduler };
+		std::atomic_int counter = 0;
+		std::function<void(int)> spawn = [&](int depth) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			counter++;
+			if (depth > 0) {
+				pool.Enqueue([&spawn, depth] { spawn(depth - 1); });
+				pool.Enqueue([&spawn, depth] { spawn(depth - 1); });
+			}
+		};
+		pool.Enqueue([&spawn] { spawn(5); });
+		pool.Drain();
+		EXPECT_EQ(63, counter);
+	}
+}
+
+TEST_F(TaskPoolDrainTest, Cancellation) {
+	TaskPool pool{ "Test", 1 };
+	std::atomic_bool paused = true;
+	pool.Enqueue([&paused] {
+		while (paused) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	});
+	CancellationSource source;
+	std::atomic_int ran = 0;
+	for (int i = 0; i < 5; i++) {
+		pool.Enqueue([&ran] { ran++; }, source.GetToken());
+	}
+	pool.Enqueue([&ran] { ran++; }, CancellationToken{});
+	source.Cancel();
+	EXPECT_TRUE(source.GetToken().IsCancelled());
+	paused = false;
+	pool.Drain();
+	EXPECT_EQ(1, ran);
+	EXPECT_EQ(5u, pool.CountCancelledTasks());
+}
+
+TEST_F(TaskPoolDrainTest, EnqueueBulk) {
+	for (auto scheduler : { TaskPool::Scheduler::SHARED_QUEUE, TaskPool::Scheduler::WORK_STEALING }) {
+		TaskPool pool{ "Test", 4, scheduler };
+		std::atomic_int counter = 0;
+		std::vector<std::function<void()>> tasks(100, [&counter] { counter++; });
+		pool.EnqueueBulk(tasks);
+		pool.Enqueue([&] {
+			pool.EnqueueBulk(std::vector<std::function<void()>>(50, [&counter] { counter++; }));
+		});
+		pool.Drain();
+		EXPECT_EQ(150, counter);
+		EXPECT_EQ(100u, tasks.size());
+	}
+}
+
+TEST_F(TaskPoolDrainTest, ClearWaitingTasksReleasesDrain) {
+	TaskPool pool{ "Test", 1 };
+	std::atomic_bool paused = true;
+	pool.Enqueue([&paused] {
+		while (paused) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	});
+	for (int i = 0; i < 10; i++) {
+		pool.Enqueue([] {});
+	}
+	EXPECT_TRUE(Eventually::Holds([&] { return pool.CountRunningTasks() == 1; }));
+	pool.ClearWaitingTasks();
+	paused = false;
+	pool.Drain();
+	EXPECT_TRUE(pool.IsEmpty());
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+
+#include "gtest/gtest.h"
+#include "Task/TaskPool.hpp"
+#include "Eventually.hpp"
+
+class TaskPoolStatisticsTest : public ::testing::Test {};
+
+using namespace Framework::Task;
+
+TEST_F(TaskPoolStatisticsTest, Disabled) {
+	TaskPool pool{ "Test", 2 };
+	pool.Enqueue([] {});
+	pool.Drain();
+	EXPECT_TRUE(pool.GetWorkerStatistics().empty());
+	EXPECT_EQ(0u, pool.GetStatistics().executedTasks);
+}
+
+TEST_F(TaskPoolStatisticsTest, Collects) {
+	for (auto scheduler : { TaskPool::Scheduler::SHARED_QUEUE, TaskPool::Scheduler::WORK_STEALING }) {
+		TaskPool::Options options;
+		options.concurrency = 2;
+		options.scheduler = scheduler;
+		options.statistics = true;
+		TaskPool pool{ "Test", options };
+		for (int i = 0; i < 20; i++) {
+			pool.Enqueue([] { std::this_thread::sleep_for(std::chrono::milliseconds(1)); });
+		}
+		EXPECT_TRUE(Eventually::Holds([&] { return pool.GetStatistics().executedTasks == 20; }));
+		EXPECT_EQ(2u, pool.GetWorkerStatistics().size());
+		auto statistics = pool.GetStatistics();
+		EXPECT_EQ(20u, statistics.executedTasks);
+		EXPECT_EQ(20u, statistics.execution.Count());
+		EXPECT_EQ(20u, statistics.queueWait.Count());
+		EXPECT_GE(statistics.execution.Percentile(50), 1000000u);
+
+		// A wait is only accounted once it ends, so keep handing work to the now idle workers.
+		EXPECT_TRUE(Eventually::Holds([&] {
+			pool.Enqueue([] {});
+			statistics = pool.GetStatistics();
+			return statistics.wakeups > 0 && statistics.idleTime.count() > 0;
+		}));
+		pool.Drain();
+	}
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Task/TaskPool.hpp"
+#include "Eventually.hpp"
+
+class TaskPriorityTest : public ::testing::Test {};
+
+using namespace Framework::Task;
+
+TEST_F(TaskPriorityTest, QueueOrder) {
+	PriorityTaskQueue<std::string> queue;
+	auto now = PriorityTaskQueue<std::string>::Clock::now();
+	queue.Push("low", TaskPriority::LOW);
+	queue.Push("normal", TaskPriority::NORMAL);
+	queue.Push("late", TaskPriority::NORMAL, now + std::chrono::seconds(2));
+	queue.Push("early", TaskPriority::NORMAL, now + std::chrono::seconds(1));
+	queue.Push("high", TaskPriority::HIGH);
+	EXPECT_EQ(5u, queue.Size());
+	EXPECT_EQ(3u, queue.Size(TaskPriority::NORMAL));
+
+	std::vector<std::string> order;
+	while (!queue.Empty()) {
+		order.push_back(queue.Pop().first);
+	}
+	EXPECT_EQ((std::vector<std::string>{ "high", "early", "late", "normal", "low" }), order);
+}
+
+TEST_F(TaskPriorityTest, StarvationLimit) {
+	PriorityTaskQueue<int> queue{ 3 };
+	queue.Push(-1, TaskPriority::LOW);
+	for (int i = 0; i < 10; i++) {
+		queue.Push(int{ i }, TaskPriority::HIGH);
+	}
+	std::vector<int> order;
+	for (int i = 0; i < 5; i++) {
+		order.push_back(queue.Pop().first);
+	}
+	EXPECT_EQ((std::vector<int>{ 0, 1, 2, -1, 3 }), order);
+}
+
+TEST_F(TaskPriorityTest, DeadlinesDoNotStarveFifo) {
+	PriorityTaskQueue<int> queue{ 2 };
+	auto deadline = PriorityTaskQueue<int>::Clock::now() + std::chrono::seconds(1);
+	queue.Push(-1);
+	queue.Push(-2);
+	for (int i = 0; i < 5; i++) {
+		queue.Push(int{ i }, TaskPriority::NORMAL, deadline);
+	}
+	std::vector<int> order;
+	while (!queue.Empty()) {
+		order.push_back(queue.Pop().first);
+	}
+	EXPECT_EQ((std::vector<int>{ 0, 1, -1, 2, 3, -2, 4 }), order);
+}
+
+TEST_F(TaskPriorityTest, Pool) {
+	TaskPool pool{ "Test", 1 };
+	std::atomic_bool paused = true;
+	pool.Enqueue([&paused] {
+		while (paused) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	});
+	EXPECT_TRUE(Eventually::Holds([&] { return pool.CountRunningTasks() == 1; }));
+
+	std::mutex mutex;
+	std::vector<int> order;
+	auto record = [&](int value) {
+		return [&, value] {
+			std::lock_guard<std::mutex> lock(mutex);
+			order.push_back(value);
+		};
+	};
+	pool.Enqueue(record(3), TaskPool::Priority::LOW);
+	pool.Enqueue(record(2));
+	pool.Enqueue(record(1), TaskPool::Priority::HIGH);
+	EXPECT_EQ(1u, pool.CountWaitingTasks(TaskPool::Priority::LOW));
+	EXPECT_EQ(3u, pool.CountWaitingTasks());
+	paused = false;
+	pool.Stop();
+
+	EXPECT_EQ((std::vector<int>{ 1, 2, 3 }), order);
+	EXPECT_EQ(1u, pool.CountDispatchedTasks(TaskPool::Priority::HIGH));
+	EXPECT_EQ(2u, pool.CountDispatchedTasks(TaskPool::Priority::NORMAL));
+	EXPECT_EQ(1u, pool.CountDispatchedTasks(TaskPool::Priority::LOW));
+}
+
+TEST_F(TaskPriorityTest, WorkStealingPool) {
+	TaskPool pool{ "Test", 1, TaskPool::Scheduler::WORK_STEALING };
+	std::mutex mutex;
+	std::vector<int> order;
+	std::atomic_bool done = false;
+	pool.Enqueue([&] {
+		pool.Enqueue([&] { std::lock_guard<std::mutex> lock(mutex); order.push_back(2); });
+		pool.Enqueue([&] { std::lock_guard<std::mutex> lock(mutex); order.push_back(1); }, TaskPool::Priority::HIGH);
+		done = true;
+	});
+	while (!done) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	pool.Stop();
+	EXPECT_EQ((std::vector<int>{ 1, 2 }), order);
+}
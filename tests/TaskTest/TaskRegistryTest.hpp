@@ -0,0 +1,61 @@
+#pragma once
+
+#include <unordered_map>
+
+#include "gtest/gtest.h"
+#include "Task/TaskBase.hpp"
+#include "Task/EventRequest.hpp"
+
+class TaskRegistryTest : public ::testing::Test {};
+
+using namespace Framework::Task;
+
+TEST_F(TaskRegistryTest, RegisterAndResolve) {
+	TaskId first = TaskRegistry::Register("first");
+	TaskId second = TaskRegistry::Register("second");
+	EXPECT_TRUE(first.IsValid());
+	EXPECT_NE(first, second);
+	EXPECT_EQ("first", TaskRegistry::Resolve(first));
+	EXPECT_EQ("second", TaskRegistry::Resolve(second));
+
+	TaskRegistry::Unregister(first);
+	EXPECT_EQ("", TaskRegistry::Resolve(first));
+	EXPECT_EQ("", TaskRegistry::Resolve(TaskId{}));
+	TaskRegistry::Unregister(second);
+}
+
+TEST_F(TaskRegistryTest, TaskBaseIdentity) {
+	TaskId id;
+	{
+		TaskBase task{ TaskType::UNKNOWN, "registry" };
+		id = task.GetId();
+		EXPECT_TRUE(id.IsValid());
+		EXPECT_EQ(id, task.GetTaskInfomation().id);
+		EXPECT_EQ("registry", TaskRegistry::Resolve(id));
+	}
+	EXPECT_EQ("", TaskRegistry::Resolve(id));
+}
+
+TEST_F(TaskRegistryTest, TaskEventRequest) {
+	TaskId sender = TaskRegistry::Register("sender");
+	TaskEventRequest<int> request{ sender, 3 };
+	EXPECT_EQ(sender, request.GetFrom());
+	EXPECT_EQ("sender", request.GetFromName());
+
+	std::unordered_map<TaskId, int> routes{ { sender, 1 } };
+	EXPECT_EQ(1, routes.at(request.GetFrom()));
+	TaskRegistry::Unregister(sender);
+}
+
+TEST_F(TaskRegistryTest, ReusesSlots) {
+	TaskId first = TaskRegistry::Register("first");
+	TaskRegistry::Unregister(first);
+	TaskId second = TaskRegistry::Register("second");
+	EXPECT_EQ(first.Index(), second.Index());
+	EXPECT_NE(first, second);
+	EXPECT_EQ("", TaskRegistry::Resolve(first));
+	EXPECT_EQ("second", TaskRegistry::Resolve(second));
+	TaskRegistry::Unregister(first);
+	EXPECT_EQ("second", TaskRegistry::Resolve(second));
+	TaskRegistry::Unregister(second);
+}
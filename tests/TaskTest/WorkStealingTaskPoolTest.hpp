@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+
+#include "gtest/gtest.h"
+#include "Task/TaskPool.hpp"
+#include "Eventually.hpp"
+
+class WorkStealingTaskPoolTest : public ::testing::Test {};
+
+using namespace Framework::Task;
+
+TEST_F(WorkStealingTaskPoolTest, Enqueue) {
+	TaskPool pool{ "Test", 4, TaskPool::Scheduler::WORK_STEALING };
+	EXPECT_EQ(TaskPool::Scheduler::WORK_STEALING, pool.GetScheduler());
+	std::atomic_int counter = 0;
+	for (int i = 0; i < 1000; i++) {
+		pool.Enqueue([&counter] {
+			counter++;
+		});
+	}
+	pool.Stop();
+	EXPECT_EQ(1000, counter);
+	EXPECT_TRUE(pool.IsEmpty());
+}
+
+TEST_F(WorkStealingTaskPoolTest, ForkJoin) {
+	TaskPool pool{ "Test", 4, TaskPool::Scheduler::WORK_STEALING };
+	std::atomic_int leaves = 0;
+	std::function<void(int)> fork = [&](int depth) {
+		if (depth == 0) {
+			leaves++;
+			return;
+		}
+		pool.Enqueue([&fork, depth] { fork(depth - 1); });
+		pool.Enqueue([&fork, depth] { fork(depth - 1); });
+	};
+	pool.Enqueue([&fork] { fork(12); });
+	while (leaves < (1 << 12)) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	pool.Stop();
+	EXPECT_EQ(1 << 12, leaves);
+}
+
+TEST_F(WorkStealingTaskPoolTest, CountWaitingTasks) {
+	TaskPool pool{ "Test", 1, TaskPool::Scheduler::WORK_STEALING };
+	std::atomic_bool paused = true;
+	std::atomic_bool forked = false;
+	pool.Enqueue([&] {
+		for (int i = 0; i < 5; i++) {
+			pool.Enqueue([] {});
+		}
+		forked = true;
+		while (paused) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	});
+	EXPECT_TRUE(Eventually::Holds([&] { return forked.load(); }));
+	EXPECT_EQ(5u, pool.CountWaitingTasks());
+	EXPECT_EQ(1u, pool.CountRunningTasks());
+	pool.ClearWaitingTasks();
+	EXPECT_TRUE(pool.IsEmpty());
+	paused = false;
+}
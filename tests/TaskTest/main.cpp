@@ -4,3 +4,23 @@
 // #include "StatementTask.hpp"
 // #include "TaskPoolTest.hpp"
 #include "BackGroundWorkerTest.hpp"
+#include "PayloadTest.hpp"
+#include "TaskRegistryTest.hpp"
+#include "MessageEventAggregatorTest.hpp"
+#include "RpcEventTest.hpp"
+#include "RpcEventAsyncTest.hpp"
+#include "WorkStealingTaskPoolTest.hpp"
+#include "TaskFutureTest.hpp"
+#include "ParallelTest.hpp"
+#include "CpuTopologyTest.hpp"
+#include "TaskPriorityTest.hpp"
+#include "ElasticTaskPoolTest.hpp"
+#include "TaskPoolDrainTest.hpp"
+#include "HistogramTest.hpp"
+#include "TaskPoolStatisticsTest.hpp"
+#include "MailboxMetricsTest.hpp"
+#include "BoundedMailboxTest.hpp"
+#include "CoalescingTest.hpp"
+#include "MultiplexedTaskTest.hpp"
+#include "PriorityLaneTest.hpp"
+#include "EventBusTest.hpp"